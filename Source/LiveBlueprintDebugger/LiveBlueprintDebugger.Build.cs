@@ -39,6 +39,9 @@ public class LiveBlueprintDebugger : ModuleRules
 				"EditorWidgets",
 				"Kismet",
 				"KismetWidgets",
+				"WorkspaceMenuStructure",
+				"DesktopPlatform",
+				"Json",
 			}
 			);
 		
@@ -0,0 +1,123 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "PropertyValueHasher.h"
+
+// FContainerElementHelper provides uniform, index-based access to the elements of array, set, and
+// map properties. Set and map storage is sparse, so the element indices passed to the functor are
+// logical indices that skip over unused slots, which matches the order elements are displayed in.
+class FContainerElementHelper
+{
+public:
+	FContainerElementHelper(EPropertyValueKind ValueKind, const FProperty* Property, const void* ValuePointer) :
+		ValueKind(ValueKind),
+		Property(Property),
+		ValuePointer(ValuePointer)
+	{
+	}
+
+	int32 Num() const
+	{
+		switch (ValueKind)
+		{
+			case EPropertyValueKind::Array:
+				return FScriptArrayHelper{ static_cast<const FArrayProperty*>(Property), ValuePointer }.Num();
+
+			case EPropertyValueKind::Map:
+				return FScriptMapHelper{ static_cast<const FMapProperty*>(Property), ValuePointer }.Num();
+
+			case EPropertyValueKind::Set:
+				return FScriptSetHelper{ static_cast<const FSetProperty*>(Property), ValuePointer }.Num();
+
+			default:
+				return 0;
+		}
+	}
+
+	// Calls Functor(ElementIndex, KeyProperty, KeyPointer, ElementProperty, ElementPointer) for
+	// every element. The key property and pointer are only set for maps, in which case the element
+	// is the map value.
+	template <typename FunctorType>
+	void ForEachElement(FunctorType&& Functor) const
+	{
+		ForEachElementInRange(0, MAX_int32, Forward<FunctorType>(Functor));
+	}
+
+	// Same as ForEachElement, but only visits the elements in [FirstElement, FirstElement + NumElements).
+	template <typename FunctorType>
+	void ForEachElementInRange(int32 FirstElement, int32 NumElements, FunctorType&& Functor) const
+	{
+		const int32 EndElement = (NumElements > MAX_int32 - FirstElement) ? MAX_int32 : FirstElement + NumElements;
+
+		switch (ValueKind)
+		{
+			case EPropertyValueKind::Array:
+			{
+				const FArrayProperty* ArrayProperty = static_cast<const FArrayProperty*>(Property);
+				FScriptArrayHelper ArrayHelper{ ArrayProperty, ValuePointer };
+
+				for (int32 i = FirstElement; i < FMath::Min(EndElement, ArrayHelper.Num()); i++)
+				{
+					Functor(i, nullptr, nullptr, ArrayProperty->Inner, ArrayHelper.GetRawPtr(i));
+				}
+				break;
+			}
+
+			case EPropertyValueKind::Map:
+			{
+				FScriptMapHelper MapHelper{ static_cast<const FMapProperty*>(Property), ValuePointer };
+				int32 ElementIndex = 0;
+
+				for (int32 i = 0; i < MapHelper.GetMaxIndex() && ElementIndex < EndElement; i++)
+				{
+					if (MapHelper.IsValidIndex(i))
+					{
+						if (ElementIndex >= FirstElement)
+						{
+							Functor(
+								ElementIndex,
+								MapHelper.GetKeyProperty(),
+								MapHelper.GetKeyPtr(i),
+								MapHelper.GetValueProperty(),
+								MapHelper.GetValuePtr(i));
+						}
+
+						ElementIndex++;
+					}
+				}
+				break;
+			}
+
+			case EPropertyValueKind::Set:
+			{
+				FScriptSetHelper SetHelper{ static_cast<const FSetProperty*>(Property), ValuePointer };
+				int32 ElementIndex = 0;
+
+				for (int32 i = 0; i < SetHelper.GetMaxIndex() && ElementIndex < EndElement; i++)
+				{
+					if (SetHelper.IsValidIndex(i))
+					{
+						if (ElementIndex >= FirstElement)
+						{
+							Functor(ElementIndex, nullptr, nullptr, SetHelper.GetElementProperty(), SetHelper.GetElementPtr(i));
+						}
+
+						ElementIndex++;
+					}
+				}
+				break;
+			}
+
+			default:
+				break;
+		}
+	}
+
+private:
+	EPropertyValueKind ValueKind;
+	const FProperty* Property;
+	const void* ValuePointer;
+};
@@ -3,11 +3,11 @@
 #include "FastPropertyInstanceInfo.h"
 
 #include "LiveBlueprintDebugger.h"
+#include "LiveBlueprintDebuggerStats.h"
+#include "PropertyValueHasher.h"
 
 #include "Kismet2/KismetDebugUtilities.h"
 
-#include <string_view>
-
 #define LOCTEXT_NAMESPACE "FLiveBlueprintDebuggerModule"
 
 FFastPropertyInstanceInfo::FFastPropertyInstanceInfo(
@@ -16,13 +16,10 @@ FFastPropertyInstanceInfo::FFastPropertyInstanceInfo(
 		ValuePointer(Property->ContainerPtrToValuePtr<void>(Container)),
 		Property(Property)
 {
-	PopulateChildren();
 	PopulateObject();
 	PopulateText();
 }
 
-#if ENGINE_MAJOR_VERSION == 4
-
 FFastPropertyInstanceInfo::FFastPropertyInstanceInfo(
 	void* ValuePointer, 
 	const FProperty* Property, 
@@ -30,12 +27,11 @@ FFastPropertyInstanceInfo::FFastPropertyInstanceInfo(
 		ValuePointer(ValuePointer),
 		Property(Property)
 {
-	PopulateChildren();
 	PopulateObject();
 	PopulateText();
 }
 
-#else
+#if ENGINE_MAJOR_VERSION == 5
 
 FFastPropertyInstanceInfo::FFastPropertyInstanceInfo(
 	void* ValuePointer,
@@ -78,69 +74,18 @@ void* FFastPropertyInstanceInfo::GetValuePointer() const
 
 uint32 FFastPropertyInstanceInfo::GetValueHash() const
 {
-	uint32 ValueHash = 0;
-
-	// For array, map, and set properties, seed the hash with the number of elements. This will cause 
-	// the hash to change if the number of elements change without needing to reinitialize all of the
-	// child elements.
-	if (auto ArrayProperty = CastField<FArrayProperty>(Property.Get()); ArrayProperty != nullptr)
-	{
-		FScriptArrayHelper ArrayHelper{ ArrayProperty, ValuePointer };
-		ValueHash = ArrayHelper.Num();
-	}
-	else if (auto MapProperty = CastField<FMapProperty>(Property.Get()); MapProperty != nullptr)
-	{
-		FScriptMapHelper MapHelper{ MapProperty, ValuePointer };
-		ValueHash = MapHelper.Num();
-	}
-	else if (auto SetProperty = CastField<FSetProperty>(Property.Get()); SetProperty != nullptr)
-	{
-		FScriptSetHelper SetHelper{ SetProperty, ValuePointer };
-		ValueHash = SetHelper.Num();
-	}
-
-	if (Property->IsA<FStructProperty>() ||
-		Property->IsA<FArrayProperty>() ||
-		Property->IsA<FMapProperty>() ||
-		Property->IsA<FSetProperty>())
-	{
-		for (auto& Child : Children)
-		{
-#if ENGINE_MAJOR_VERSION == 4
-			ValueHash = HashCombine(
-				ValueHash,
-				Child.GetValueHash());
-#else
-			ValueHash = HashCombineFast(
-				ValueHash,
-				Child.GetValueHash());
-#endif
-		}
-	}
-	else if (Property->IsA<FInterfaceProperty>())
-	{
-		// FInterfaceProperty doesn't define a GetValueTypeHashInternal override function, so we instead
-		// use the hash of its value string.
-
-		FString ValueString = ValueText.ToString();
-		std::hash<std::wstring_view> Hasher;
-		ValueHash = Hasher({ *ValueString, static_cast<size_t>(ValueString.Len()) });
-	}
-	else if ((Property->PropertyFlags & CPF_HasGetValueTypeHash))
-	{
-		// Unreal Engine 4.27, 5.0, and 5.2 have issues with the generic GetValueTypeHash function, so we
-		// will instead calculate the hash of the value text using the standard library. Strangely, 
-		// GetValueTypeHash work fine in Unreal Engine 5.1, but this STL method works in all cases.
-		FString ValueString = ValueText.ToString();
-		std::hash<std::wstring_view> Hasher;
-		ValueHash = Hasher({ *ValueString, static_cast<size_t>(ValueString.Len()) });
-	}
-
-	return ValueHash;
+	// Hash the live value in memory rather than ValueText, which is only regenerated on Refresh
+	// and is comparatively expensive to build.
+	return FPropertyValueHasher::HashValue(Property.Get(), ValuePointer);
 }
 
 TArray<FFastPropertyInstanceInfo>& FFastPropertyInstanceInfo::GetChildren()
 {
+	if (!bChildrenPopulated)
+	{
+		PopulateChildren();
+	}
+
 	return Children;
 }
 
@@ -156,17 +101,62 @@ const TWeakObjectPtr<UObject>& FFastPropertyInstanceInfo::GetObject() const
 
 void FFastPropertyInstanceInfo::Refresh()
 {
-	PopulateChildren();
+	// Children are repopulated the next time they are asked for.
+	Children.Empty();
+	bChildrenPopulated = false;
+
 	PopulateObject();
 	PopulateText();
 }
 
 bool FFastPropertyInstanceInfo::ShouldExpandProperty(FFastPropertyInstanceInfo& PropertyInstanceInfo)
+{
+	return ShouldExpandProperty(PropertyInstanceInfo.GetProperty().Get());
+}
+
+bool FFastPropertyInstanceInfo::ShouldExpandProperty(const FProperty* Property)
 {
 	return (
 		// We only support expanding struct properties in the details panel UI.
-		PropertyInstanceInfo.GetProperty()->IsA<FStructProperty>() &&
-		PropertyInstanceInfo.GetProperty()->HasAllPropertyFlags(CPF_BlueprintVisible));
+		Property->IsA<FStructProperty>() &&
+		Property->HasAllPropertyFlags(CPF_BlueprintVisible));
+}
+
+FText FFastPropertyInstanceInfo::GetPropertyTypeText(const FProperty* Property)
+{
+	if (auto ObjectPropertyBase = CastField<FObjectPropertyBase>(Property); 
+		ObjectPropertyBase != nullptr && ObjectPropertyBase->PropertyClass != nullptr)
+	{
+		return ObjectPropertyBase->PropertyClass->GetDisplayNameText();
+	}
+	else if (auto StructProperty = CastField<FStructProperty>(Property); StructProperty != nullptr)
+	{
+		return StructProperty->Struct->GetDisplayNameText();
+	}
+	else if (auto ArrayProperty = CastField<FArrayProperty>(Property); 
+		ArrayProperty != nullptr && ArrayProperty->Inner != nullptr)
+	{
+		return FText::FromString(
+			FString::Format(TEXT("Array of {0}"), { ArrayProperty->Inner->GetClass()->GetName() }));
+	}
+	else if (auto MapProperty = CastField<FMapProperty>(Property); 
+		MapProperty != nullptr && MapProperty->KeyProp != nullptr && MapProperty->ValueProp != nullptr)
+	{
+		return FText::FromString(
+			FString::Format(TEXT("Map of {0} to {1}"), 
+				{ 
+					MapProperty->KeyProp->GetClass()->GetName(),
+					MapProperty->ValueProp->GetClass()->GetName()
+				}));
+	}
+	else if (auto SetProperty = CastField<FSetProperty>(Property); 
+		SetProperty != nullptr && SetProperty->ElementProp != nullptr)
+	{
+		return FText::FromString(
+			FString::Format(TEXT("Array of {0}"), { SetProperty->ElementProp->GetClass()->GetName() }));
+	}
+
+	return Property->GetClass()->GetDisplayNameText();
 }
 
 #if ENGINE_MAJOR_VERSION == 4
@@ -258,7 +248,7 @@ FText FFastPropertyInstanceInfo::GetValueTextOfAllChildren()
 	FString ValueTextBuilder = L"{";
 
 	ValueTextBuilder += FString::JoinBy(
-		Children,
+		GetChildren(),
 		TEXT(", "),
 		[](auto& Child)
 		{
@@ -275,6 +265,46 @@ FText FFastPropertyInstanceInfo::GetValueTextOfAllChildren()
 	return FText::FromString(ValueTextBuilder);
 }
 
+FText FFastPropertyInstanceInfo::GetStructSummaryText() const
+{
+	const FStructProperty* StructProperty = CastFieldChecked<const FStructProperty>(Property.Get());
+	FString ValueTextBuilder = L"{";
+	bool bIsFirstMember = true;
+
+	for (TFieldIterator<FProperty> It(StructProperty->Struct); It; ++It)
+	{
+		FString MemberValueString;
+
+		if (It->IsA<FStructProperty>())
+		{
+			MemberValueString = TEXT("{...}");
+		}
+		else
+		{
+			FFastPropertyInstanceInfo MemberInfo{ ValuePointer, *It };
+			MemberValueString = MemberInfo.GetValue().ToString();
+		}
+
+		if (!bIsFirstMember)
+		{
+			ValueTextBuilder += TEXT(", ");
+		}
+
+		ValueTextBuilder += FString::Format(
+			TEXT("{0}: {1}"),
+			{
+				It->GetDisplayNameText().ToString(),
+				MemberValueString
+			});
+
+		bIsFirstMember = false;
+	}
+
+	ValueTextBuilder += L"}";
+
+	return FText::FromString(ValueTextBuilder);
+}
+
 void FFastPropertyInstanceInfo::PopulateText()
 {
 	DisplayNameText = Property->GetDisplayNameText();
@@ -293,45 +323,18 @@ void FFastPropertyInstanceInfo::PopulateText()
 			ValueText = FText::FromString(L"None");
 		}
 	}
-	else if (auto StructProperty = CastField<FStructProperty>(*Property); StructProperty != nullptr)
-	{
-		ValueText = GetValueTextOfAllChildren();
-		TypeText = StructProperty->Struct->GetDisplayNameText();
-	}
-	else if (auto ArrayProperty = CastField<FArrayProperty>(*Property); ArrayProperty != nullptr)
+	else if (Property->IsA<FStructProperty>())
 	{
-		ValueText = GetValueTextOfAllChildren();
-
-		if (ArrayProperty->Inner != nullptr)
-		{
-			TypeText = FText::FromString(
-				FString::Format(TEXT("Array of {0}"), { ArrayProperty->Inner->GetClass()->GetName() }));
-		}
+		ValueText = GetStructSummaryText();
+		TypeText = GetPropertyTypeText(*Property);
 	}
-	else if (auto MapProperty = CastField<FMapProperty>(*Property); MapProperty != nullptr)
-	{
-		ValueText = GetValueTextOfAllChildren();
-
-		if (MapProperty->KeyProp != nullptr &&
-			MapProperty->ValueProp != nullptr)
-		{
-			TypeText = FText::FromString(
-				FString::Format(TEXT("Map of {0} to {1}"), 
-					{ 
-						MapProperty->KeyProp->GetClass()->GetName(),
-						MapProperty->ValueProp->GetClass()->GetName()
-					}));
-		}
-	}
-	else if (auto SetProperty = CastField<FSetProperty>(*Property); SetProperty != nullptr)
+	else if (
+		Property->IsA<FArrayProperty>() ||
+		Property->IsA<FMapProperty>() ||
+		Property->IsA<FSetProperty>())
 	{
 		ValueText = GetValueTextOfAllChildren();
-
-		if (SetProperty->ElementProp != nullptr)
-		{
-			TypeText = FText::FromString(
-				FString::Format(TEXT("Array of {0}"), { SetProperty->ElementProp->GetClass()->GetName() }));
-		}
+		TypeText = GetPropertyTypeText(*Property);
 	}
 	else
 	{
@@ -359,7 +362,10 @@ void FFastPropertyInstanceInfo::PopulateText()
 
 void FFastPropertyInstanceInfo::PopulateChildren()
 {
+	LIVE_BLUEPRINT_SCOPE(PopulateChildren);
+
 	Children.Empty();
+	bChildrenPopulated = true;
 
 	if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property.Get()); StructProperty != nullptr)
 	{
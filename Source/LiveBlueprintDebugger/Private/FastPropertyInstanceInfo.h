@@ -13,15 +13,19 @@
 //
 // Even so, FFastPropertyInstanceInfo uses the FPropertyInstanceInfo class and helper functions 
 // wherever possible to avoid duplicating work.
+//
+// Children are only populated the first time GetChildren is called. The value text of a struct is
+// a summary that only formats its immediate members, with nested structs shown as "{...}", so 
+// constructing the info for a deeply nested struct does not build the whole subtree.
 class FFastPropertyInstanceInfo
 {
 public:
 	FFastPropertyInstanceInfo(void* Container, const FProperty* Property);
 
-#if ENGINE_MAJOR_VERSION == 4
 	struct value_pointer_marker {};
 	FFastPropertyInstanceInfo(void* ValuePointer, const FProperty* Property, value_pointer_marker);
-#else
+
+#if ENGINE_MAJOR_VERSION == 5
 	FFastPropertyInstanceInfo(void* ValuePointer, const TSharedPtr<struct FPropertyInstanceInfo>& PropertyInstanceInfo);
 #endif
 
@@ -38,6 +42,8 @@ public:
 	void Refresh();
 
 	static bool ShouldExpandProperty(FFastPropertyInstanceInfo& PropertyInstanceInfo);
+	static bool ShouldExpandProperty(const FProperty* Property);
+	static FText GetPropertyTypeText(const FProperty* Property);
 
 #if ENGINE_MAJOR_VERSION == 4
 	static FText GetPropertyValueText_UE4(const FProperty* Property, const void* PropertyValue);
@@ -46,6 +52,7 @@ public:
 private:
 	void PopulateObject();
 	FText GetValueTextOfAllChildren();
+	FText GetStructSummaryText() const;
 	void PopulateText();
 	void PopulateChildren();
 	
@@ -56,4 +63,5 @@ private:
 	FText TypeText;
 	TWeakObjectPtr<UObject> Object = nullptr;
 	TArray<FFastPropertyInstanceInfo> Children;
+	bool bChildrenPopulated = false;
 };
@@ -0,0 +1,54 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "LiveBlueprintArena.h"
+
+FLiveBlueprintArena::~FLiveBlueprintArena()
+{
+	Reset();
+}
+
+void FLiveBlueprintArena::Reserve(SIZE_T NumBytes)
+{
+	if (Cursor != nullptr && Cursor + NumBytes <= End)
+	{
+		return;
+	}
+
+	// Whatever is left of the current block is wasted, which is fine since the arena is meant to be
+	// reserved once up front.
+	const SIZE_T BlockSize = FMath::Max(NumBytes, MinBlockSize);
+	uint8* Block = static_cast<uint8*>(FMemory::Malloc(BlockSize));
+
+	Blocks.Add(Block);
+	AllocatedSize += BlockSize;
+	Cursor = Block;
+	End = Block + BlockSize;
+}
+
+void* FLiveBlueprintArena::Allocate(SIZE_T NumBytes, SIZE_T Alignment)
+{
+	Reserve(NumBytes + Alignment - 1);
+
+	uint8* Allocation = Align(Cursor, Alignment);
+	Cursor = Allocation + NumBytes;
+
+	return Allocation;
+}
+
+void FLiveBlueprintArena::Reset()
+{
+	for (void* Block : Blocks)
+	{
+		FMemory::Free(Block);
+	}
+
+	Blocks.Empty();
+	AllocatedSize = 0;
+	Cursor = nullptr;
+	End = nullptr;
+}
+
+SIZE_T FLiveBlueprintArena::GetAllocatedSize() const
+{
+	return AllocatedSize + Blocks.GetAllocatedSize();
+}
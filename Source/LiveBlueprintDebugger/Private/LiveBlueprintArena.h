@@ -0,0 +1,65 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// FLiveBlueprintArena is a linear allocator for state that lives exactly as long as one selection
+// in the details panel.
+//
+// Allocations are carved out of large blocks one after the other and are never freed on their own.
+// Every block is released at once by Reset or when the arena is destroyed, so selecting one Actor
+// after another doesn't leave many small allocations behind to fragment the heap. Call Reserve
+// with the total size first to get everything in a single block. Nothing allocated from the arena
+// is ever destroyed, so only trivially destructible types can be allocated.
+class FLiveBlueprintArena
+{
+public:
+	FLiveBlueprintArena() = default;
+	~FLiveBlueprintArena();
+
+	FLiveBlueprintArena(const FLiveBlueprintArena&) = delete;
+	FLiveBlueprintArena& operator=(const FLiveBlueprintArena&) = delete;
+
+	void Reserve(SIZE_T NumBytes);
+	void* Allocate(SIZE_T NumBytes, SIZE_T Alignment);
+	void Reset();
+	SIZE_T GetAllocatedSize() const;
+
+	template<typename ElementType>
+	TArrayView<ElementType> AllocateArray(int32 Num, const ElementType& InitialValue);
+
+	// The number of bytes AllocateArray needs for Num elements, including the worst-case padding
+	// for alignment, for use with Reserve.
+	template<typename ElementType>
+	static SIZE_T GetArraySize(int32 Num);
+
+private:
+	static constexpr SIZE_T MinBlockSize = 16 * 1024;
+
+	TArray<void*> Blocks;
+	SIZE_T AllocatedSize = 0;
+	uint8* Cursor = nullptr;
+	uint8* End = nullptr;
+};
+
+template<typename ElementType>
+TArrayView<ElementType> FLiveBlueprintArena::AllocateArray(int32 Num, const ElementType& InitialValue)
+{
+	static_assert(TIsTriviallyDestructible<ElementType>::Value, "The arena never destroys what it allocates.");
+
+	ElementType* Elements = static_cast<ElementType*>(Allocate(sizeof(ElementType) * Num, alignof(ElementType)));
+
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		new (Elements + Index) ElementType(InitialValue);
+	}
+
+	return TArrayView<ElementType>(Elements, Num);
+}
+
+template<typename ElementType>
+SIZE_T FLiveBlueprintArena::GetArraySize(int32 Num)
+{
+	return sizeof(ElementType) * Num + alignof(ElementType) - 1;
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+// FLiveBlueprintByteQueue is a fixed-capacity, lock-free queue of bytes for exactly one producer
+// thread and one consumer thread.
+//
+// The buffer is allocated once up front. The producer only ever advances the write offset and the
+// consumer only ever advances the read offset, so neither side needs a lock. Writes are all or
+// nothing: if a record does not fit, TryWrite fails and nothing is written, so the consumer never
+// sees a partial record.
+class FLiveBlueprintByteQueue
+{
+public:
+	explicit FLiveBlueprintByteQueue(int32 CapacityInBytes) :
+		Capacity(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(CapacityInBytes, 1024))))
+	{
+		Buffer.SetNumUninitialized(Capacity);
+	}
+
+	// Producer only.
+	bool TryWrite(const uint8* Data, int32 NumBytes)
+	{
+		const uint64 WriteOffset = WriteOffsetAtomic.load(std::memory_order_relaxed);
+		const uint64 ReadOffset = ReadOffsetAtomic.load(std::memory_order_acquire);
+
+		if (Capacity - (WriteOffset - ReadOffset) < static_cast<uint64>(NumBytes))
+		{
+			return false;
+		}
+
+		CopyIn(WriteOffset, Data, NumBytes);
+		WriteOffsetAtomic.store(WriteOffset + NumBytes, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer only. Calls Consume(Data, NumBytes) for every contiguous span of bytes that is ready
+	// and then releases them back to the producer. Returns the number of bytes consumed.
+	template <typename FunctorType>
+	int64 Drain(FunctorType&& Consume)
+	{
+		const uint64 ReadOffset = ReadOffsetAtomic.load(std::memory_order_relaxed);
+		const uint64 WriteOffset = WriteOffsetAtomic.load(std::memory_order_acquire);
+		const uint64 NumBytes = WriteOffset - ReadOffset;
+
+		if (NumBytes == 0)
+		{
+			return 0;
+		}
+
+		const uint32 Start = static_cast<uint32>(ReadOffset & (Capacity - 1));
+		const uint32 FirstSpan = static_cast<uint32>(FMath::Min<uint64>(NumBytes, Capacity - Start));
+
+		Consume(Buffer.GetData() + Start, FirstSpan);
+
+		if (FirstSpan < NumBytes)
+		{
+			Consume(Buffer.GetData(), static_cast<uint32>(NumBytes - FirstSpan));
+		}
+
+		ReadOffsetAtomic.store(WriteOffset, std::memory_order_release);
+		return static_cast<int64>(NumBytes);
+	}
+
+private:
+	void CopyIn(uint64 Offset, const uint8* Data, int32 NumBytes)
+	{
+		const uint32 Start = static_cast<uint32>(Offset & (Capacity - 1));
+		const uint32 FirstSpan = FMath::Min<uint32>(NumBytes, Capacity - Start);
+
+		FMemory::Memcpy(Buffer.GetData() + Start, Data, FirstSpan);
+
+		if (FirstSpan < static_cast<uint32>(NumBytes))
+		{
+			FMemory::Memcpy(Buffer.GetData(), Data + FirstSpan, NumBytes - FirstSpan);
+		}
+	}
+
+	const uint32 Capacity;
+	TArray<uint8> Buffer;
+
+	// Offsets only ever grow. Their difference is the number of bytes in the queue.
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> WriteOffsetAtomic{ 0 };
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> ReadOffsetAtomic{ 0 };
+};
@@ -0,0 +1,210 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "LiveBlueprintClassLayout.h"
+
+#include "Editor.h"
+#include "FastPropertyInstanceInfo.h"
+#include "LiveBlueprintDebugger.h"
+#include "LiveBlueprintDebuggerStats.h"
+
+static const FString c_PrivateCategoryName = "Private Implementation Variables";
+
+FLiveBlueprintClassLayout::FLiveBlueprintClassLayout(UClass* Class, uint32 Generation) :
+	Class(Class),
+	Generation(Generation)
+{
+	LIVE_BLUEPRINT_SCOPE(BuildClassLayout);
+
+	UE_LOG(
+		LogLiveBlueprintDebugger,
+		Verbose,
+		TEXT("Building property layout for class '%s'..."),
+		*Class->GetName());
+
+	// Categorize and sort the properties associated with this Blueprint class.
+	TMap<FString, TArray<const FProperty*>> PropertiesByCategory;
+	for (auto Iterator = TFieldIterator<FProperty>(Class); Iterator != nullptr; ++Iterator)
+	{
+		const FProperty* Property = *Iterator;
+
+		if (Property->HasAllPropertyFlags(CPF_BlueprintVisible))
+		{
+			PropertiesByCategory.FindOrAdd(GetPropertyCategoryString(Property)).Add(Property);
+		}
+	}
+
+	for (auto& [CategoryString, CategoryProperties] : PropertiesByCategory)
+	{
+		FLiveBlueprintCategoryLayout& Category = Categories.AddDefaulted_GetRef();
+		Category.CategoryString = CategoryString;
+		Category.CategoryName = *FString::Printf(TEXT("Blueprint Properties - %s"), *CategoryString);
+		Category.FirstPropertyIndex = Properties.Num();
+
+		for (const FProperty* Property : CategoryProperties)
+		{
+			const bool bAdvancedDisplay =
+				Property->HasAnyPropertyFlags(CPF_AdvancedDisplay) ||
+				(CategoryString == c_PrivateCategoryName);
+
+			AddProperty(Property, INDEX_NONE, Property->GetOffset_ForInternal(), 0, bAdvancedDisplay);
+		}
+
+		Category.NumProperties = Properties.Num() - Category.FirstPropertyIndex;
+	}
+}
+
+const TArray<FLiveBlueprintCategoryLayout>& FLiveBlueprintClassLayout::GetCategories() const
+{
+	return Categories;
+}
+
+const TArray<FLiveBlueprintPropertyLayout>& FLiveBlueprintClassLayout::GetProperties() const
+{
+	return Properties;
+}
+
+const TWeakObjectPtr<UClass>& FLiveBlueprintClassLayout::GetClass() const
+{
+	return Class;
+}
+
+uint32 FLiveBlueprintClassLayout::GetGeneration() const
+{
+	return Generation;
+}
+
+bool FLiveBlueprintClassLayout::IsStale() const
+{
+	return bIsStale;
+}
+
+void FLiveBlueprintClassLayout::MarkStale()
+{
+	bIsStale = true;
+}
+
+SIZE_T FLiveBlueprintClassLayout::GetAllocatedSize() const
+{
+	SIZE_T AllocatedSize = Categories.GetAllocatedSize() + Properties.GetAllocatedSize();
+
+	for (const FLiveBlueprintCategoryLayout& Category : Categories)
+	{
+		AllocatedSize += Category.CategoryString.GetAllocatedSize();
+	}
+
+	return AllocatedSize;
+}
+
+FString FLiveBlueprintClassLayout::GetPropertyCategoryString(const FProperty* Property)
+{
+	FString Category = c_PrivateCategoryName;
+
+	auto MetaDataMap = Property->GetMetaDataMap();
+
+	if (MetaDataMap != nullptr &&
+		MetaDataMap->Contains(FName("Category")))
+	{
+		Category = *(MetaDataMap->Find(FName("Category")));
+		Category.ReplaceInline(TEXT("|"), TEXT(" "));
+	}
+
+	return Category;
+}
+
+void FLiveBlueprintClassLayout::AddProperty(
+	const FProperty* Property,
+	int32 ParentIndex,
+	int32 Offset,
+	int32 Depth,
+	bool bAdvancedDisplay)
+{
+	const int32 PropertyIndex = Properties.Num();
+
+	FLiveBlueprintPropertyLayout& PropertyLayout = Properties.AddDefaulted_GetRef();
+	PropertyLayout.Property = Property;
+	PropertyLayout.ParentIndex = ParentIndex;
+	PropertyLayout.Offset = Offset;
+	PropertyLayout.ValueKind = FPropertyValueHasher::GetValueKind(Property);
+	PropertyLayout.Accessor = FLiveBlueprintValueAccessor::Compile(Property, PropertyLayout.ValueKind);
+	PropertyLayout.Depth = Depth;
+	PropertyLayout.DisplayName = Property->GetDisplayNameText();
+	PropertyLayout.TypeText = FFastPropertyInstanceInfo::GetPropertyTypeText(Property);
+	PropertyLayout.bAdvancedDisplay = bAdvancedDisplay;
+	PropertyLayout.bIsGroup =
+		FFastPropertyInstanceInfo::ShouldExpandProperty(Property) &&
+		(Depth <= MaxNestedGroupDepth);
+
+	if (PropertyLayout.bIsGroup)
+	{
+		const FStructProperty* StructProperty = CastFieldChecked<const FStructProperty>(Property);
+
+		for (TFieldIterator<FProperty> It(StructProperty->Struct); It; ++It)
+		{
+			AddProperty(*It, PropertyIndex, Offset + It->GetOffset_ForInternal(), Depth + 1, false);
+		}
+	}
+}
+
+FLiveBlueprintClassLayoutCache& FLiveBlueprintClassLayoutCache::Get()
+{
+	static FLiveBlueprintClassLayoutCache Instance;
+	return Instance;
+}
+
+TSharedRef<const FLiveBlueprintClassLayout> FLiveBlueprintClassLayoutCache::FindOrBuild(UClass* Class)
+{
+	RegisterInvalidationDelegates();
+
+	if (TSharedRef<FLiveBlueprintClassLayout>* ExistingLayout = Layouts.Find(Class); ExistingLayout != nullptr)
+	{
+		return *ExistingLayout;
+	}
+
+	return Layouts.Add(Class, MakeShared<FLiveBlueprintClassLayout>(Class, Generation));
+}
+
+void FLiveBlueprintClassLayoutCache::Invalidate()
+{
+	for (auto& [Class, Layout] : Layouts)
+	{
+		Layout->MarkStale();
+	}
+
+	Layouts.Empty();
+	Generation++;
+}
+
+void FLiveBlueprintClassLayoutCache::Shutdown()
+{
+	if (GEditor != nullptr)
+	{
+		GEditor->OnBlueprintCompiled().Remove(OnBlueprintCompiledDelegateHandle);
+	}
+
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(OnObjectsReplacedDelegateHandle);
+	OnBlueprintCompiledDelegateHandle.Reset();
+	OnObjectsReplacedDelegateHandle.Reset();
+	Invalidate();
+}
+
+void FLiveBlueprintClassLayoutCache::RegisterInvalidationDelegates()
+{
+	// GEditor does not necessarily exist yet when the module starts up, so we wait until the first
+	// layout is requested before registering.
+	if (!OnBlueprintCompiledDelegateHandle.IsValid() && GEditor != nullptr)
+	{
+		OnBlueprintCompiledDelegateHandle = GEditor->OnBlueprintCompiled().AddRaw(
+			this, &FLiveBlueprintClassLayoutCache::Invalidate);
+	}
+
+	if (!OnObjectsReplacedDelegateHandle.IsValid())
+	{
+		OnObjectsReplacedDelegateHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddRaw(
+			this, &FLiveBlueprintClassLayoutCache::OnObjectsReplaced);
+	}
+}
+
+void FLiveBlueprintClassLayoutCache::OnObjectsReplaced(const TMap<UObject*, UObject*>& /*ReplacementMap*/)
+{
+	Invalidate();
+}
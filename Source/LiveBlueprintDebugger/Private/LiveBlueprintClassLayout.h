@@ -0,0 +1,97 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "LiveBlueprintValueAccessor.h"
+#include "PropertyValueHasher.h"
+
+// A single Blueprint-visible property (or nested struct member) of a class layout. Nested struct
+// members follow their parent struct directly, so the property list is in depth-first order.
+struct FLiveBlueprintPropertyLayout
+{
+	const FProperty* Property = nullptr;
+
+	// Index of the enclosing struct property in FLiveBlueprintClassLayout::Properties, or
+	// INDEX_NONE for top-level properties.
+	int32 ParentIndex = INDEX_NONE;
+
+	// Offset of the property value from the start of the object.
+	int32 Offset = 0;
+
+	EPropertyValueKind ValueKind = EPropertyValueKind::Other;
+	FLiveBlueprintValueAccessor Accessor;
+
+	int32 Depth = 0;
+	FText DisplayName;
+	FText TypeText;
+	bool bAdvancedDisplay = false;
+
+	// True for struct properties that are shown as an expandable group in the details panel.
+	bool bIsGroup = false;
+};
+
+struct FLiveBlueprintCategoryLayout
+{
+	FString CategoryString;
+	FName CategoryName;
+	int32 FirstPropertyIndex = 0;
+	int32 NumProperties = 0;
+};
+
+// FLiveBlueprintClassLayout is the compiled, categorized list of Blueprint-visible properties for
+// a class. It only depends on the class, so it is built once and shared by every instance of
+// that class that is selected in the editor.
+class FLiveBlueprintClassLayout
+{
+public:
+	static constexpr int32 MaxNestedGroupDepth = 5;
+
+	FLiveBlueprintClassLayout(UClass* Class, uint32 Generation);
+
+	const TArray<FLiveBlueprintCategoryLayout>& GetCategories() const;
+	const TArray<FLiveBlueprintPropertyLayout>& GetProperties() const;
+	const TWeakObjectPtr<UClass>& GetClass() const;
+	uint32 GetGeneration() const;
+
+	// A layout becomes stale once its class has been recompiled or reinstanced. Its property
+	// pointers must not be used after that point.
+	bool IsStale() const;
+	void MarkStale();
+
+	SIZE_T GetAllocatedSize() const;
+
+	static FString GetPropertyCategoryString(const FProperty* Property);
+
+private:
+	void AddProperty(const FProperty* Property, int32 ParentIndex, int32 Offset, int32 Depth, bool bAdvancedDisplay);
+
+	TWeakObjectPtr<UClass> Class;
+	uint32 Generation = 0;
+	bool bIsStale = false;
+	TArray<FLiveBlueprintCategoryLayout> Categories;
+	TArray<FLiveBlueprintPropertyLayout> Properties;
+};
+
+// FLiveBlueprintClassLayoutCache keeps the compiled layout of every class that has been
+// customized. The whole cache is flushed whenever a Blueprint is compiled or objects are
+// reinstanced, since either can change the property layout of a class.
+class FLiveBlueprintClassLayoutCache
+{
+public:
+	static FLiveBlueprintClassLayoutCache& Get();
+
+	TSharedRef<const FLiveBlueprintClassLayout> FindOrBuild(UClass* Class);
+	void Invalidate();
+	void Shutdown();
+
+private:
+	void RegisterInvalidationDelegates();
+	void OnObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap);
+
+	TMap<TWeakObjectPtr<UClass>, TSharedRef<FLiveBlueprintClassLayout>> Layouts;
+	uint32 Generation = 0;
+	FDelegateHandle OnBlueprintCompiledDelegateHandle;
+	FDelegateHandle OnObjectsReplacedDelegateHandle;
+};
@@ -1,28 +1,88 @@
 // Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
 
 #include "LiveBlueprintDebugger.h"
+#include "LiveBlueprintClassLayout.h"
 #include "LiveBlueprintDebuggerDetailCustomization.h"
+#include "LiveBlueprintDebuggerStats.h"
 #include "LiveBlueprintDebuggerSettings.h"
+#include "LiveBlueprintRecorder.h"
+#include "LiveBlueprintSelectionState.h"
+#include "LiveBlueprintUpdateDriver.h"
+#include "SLiveBlueprintInstanceTable.h"
+#include "SLiveBlueprintReplayViewer.h"
 
 #include "ActorDetailsDelegates.h"
 #include "Editor.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Docking/TabManager.h"
+#include "IDetailsView.h"
 #include "LevelEditor.h"
 #include "PropertyEditorModule.h"
 #include "Selection.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
 
 #define LOCTEXT_NAMESPACE "FLiveBlueprintDebuggerModule"
 
 DEFINE_LOG_CATEGORY(LogLiveBlueprintDebugger);
 
+DEFINE_STAT(STAT_LiveBlueprint_Construct);
+DEFINE_STAT(STAT_LiveBlueprint_BuildClassLayout);
+DEFINE_STAT(STAT_LiveBlueprint_BuildWidgetRows);
+DEFINE_STAT(STAT_LiveBlueprint_Update);
+DEFINE_STAT(STAT_LiveBlueprint_PollRows);
+DEFINE_STAT(STAT_LiveBlueprint_DiffSnapshots);
+DEFINE_STAT(STAT_LiveBlueprint_FormatValue);
+DEFINE_STAT(STAT_LiveBlueprint_FormatValueOnWorker);
+DEFINE_STAT(STAT_LiveBlueprint_PopulateChildren);
+DEFINE_STAT(STAT_LiveBlueprint_UpdateContainerElements);
+DEFINE_STAT(STAT_LiveBlueprint_UpdateGroupRows);
+DEFINE_STAT(STAT_LiveBlueprint_UpdateHighlights);
+DEFINE_STAT(STAT_LiveBlueprint_UpdateReferenceExpansion);
+DEFINE_STAT(STAT_LiveBlueprint_RowsPolled);
+DEFINE_STAT(STAT_LiveBlueprint_RowsUpdated);
+DEFINE_STAT(STAT_LiveBlueprint_RowsSkipped);
+DEFINE_STAT(STAT_LiveBlueprint_RowMemory);
+
+TRACE_DECLARE_INT_COUNTER(LiveBlueprint_RowsPolled, TEXT("LiveBlueprintDebugger/Rows Polled"));
+TRACE_DECLARE_INT_COUNTER(LiveBlueprint_RowsUpdated, TEXT("LiveBlueprintDebugger/Rows Updated"));
+TRACE_DECLARE_INT_COUNTER(LiveBlueprint_RowsSkipped, TEXT("LiveBlueprintDebugger/Rows Skipped"));
+TRACE_DECLARE_MEMORY_COUNTER(LiveBlueprint_RowMemory, TEXT("LiveBlueprintDebugger/Row Memory"));
+
 void FLiveBlueprintDebuggerModule::StartupModule()
 {
 	// Register extended actor details provider.
 	UE_LOG(LogLiveBlueprintDebugger, Verbose, TEXT("Initializing LiveBlueprintDebugger module."));
+	SelectionStateCache = MakeUnique<FLiveBlueprintSelectionStateCache>();
+
 	DetailCustomizationDelegateHandle = OnExtendActorDetails.AddLambda(
 		[this](class IDetailLayoutBuilder& DetailBuilder, const FGetSelectedActors& /*GetSelectedActorsDelegate*/)
 		{
-			CurrentDetailCustomization.Reset();
-			CurrentDetailCustomization = FLiveBlueprintDebuggerDetailCustomization::CreateForLayoutBuilder(DetailBuilder);
+			// The panel being customized replaces its previous customization, and panels that were
+			// closed since the last customization are cleaned up.
+			const IDetailsView* DetailsView = DetailBuilder.GetDetailsView();
+
+			DetailCustomizations.RemoveAll(
+				[DetailsView](const TUniquePtr<FLiveBlueprintDebuggerDetailCustomization>& DetailCustomization)
+				{
+					return DetailCustomization->IsShownIn(DetailsView) || !DetailCustomization->IsDetailsViewOpen();
+				});
+
+			if (TUniquePtr<FLiveBlueprintDebuggerDetailCustomization> DetailCustomization = 
+					FLiveBlueprintDebuggerDetailCustomization::CreateForLayoutBuilder(DetailBuilder, *SelectionStateCache); 
+				DetailCustomization.IsValid())
+			{
+				DetailCustomizations.Add(MoveTemp(DetailCustomization));
+			}
+		});
+
+	// Cached rows were set up for the settings at the time, such as the refresh rate and whether
+	// value history is recorded, so they can't be reused once the settings change.
+	SettingsChangedDelegateHandle = GetMutableDefault<ULiveBlueprintDebuggerSettings>()->OnSettingChanged().AddLambda(
+		[this](UObject* /*Settings*/, FPropertyChangedEvent& /*PropertyChangedEvent*/)
+		{
+			SelectionStateCache->Empty();
 		});
 
 	PreBeginPIEDelegateHandle = FEditorDelegates::PreBeginPIE.AddRaw(
@@ -36,17 +96,64 @@ void FLiveBlueprintDebuggerModule::StartupModule()
 
 	OnSwitchBeginPIEAndSIEDelegateHandle = FEditorDelegates::OnSwitchBeginPIEAndSIE.AddRaw(
 		this, &FLiveBlueprintDebuggerModule::ReselectActor);
+
+	// Register the instance table tab under Window > Developer Tools > Debug.
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(
+		SLiveBlueprintInstanceTable::TabName, 
+		FOnSpawnTab::CreateLambda(
+			[](const FSpawnTabArgs& /*SpawnTabArgs*/)
+			{
+				return SNew(SDockTab)
+					.TabRole(ETabRole::NomadTab)
+					[
+						SNew(SLiveBlueprintInstanceTable)
+					];
+			}))
+		.SetDisplayName(LOCTEXT("InstanceTableTabTitle", "Live Blueprint Instances"))
+		.SetTooltipText(LOCTEXT("InstanceTableTabToolTip", "Shows the live Blueprint variables of every instance of a Blueprint class while playing in the editor."))
+		.SetGroup(WorkspaceMenu::GetMenuStructure().GetDeveloperToolsDebugCategory());
+
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(
+		SLiveBlueprintReplayViewer::TabName, 
+		FOnSpawnTab::CreateLambda(
+			[](const FSpawnTabArgs& /*SpawnTabArgs*/)
+			{
+				return SNew(SDockTab)
+					.TabRole(ETabRole::NomadTab)
+					[
+						SNew(SLiveBlueprintReplayViewer)
+					];
+			}))
+		.SetDisplayName(LOCTEXT("ReplayTabTitle", "Live Blueprint Replay"))
+		.SetTooltipText(LOCTEXT("ReplayTabToolTip", "Shows the Blueprint variables of a recorded play session at any point in time."))
+		.SetGroup(WorkspaceMenu::GetMenuStructure().GetDeveloperToolsDebugCategory());
 }
 
 void FLiveBlueprintDebuggerModule::ShutdownModule()
 {
+	if (FSlateApplication::IsInitialized())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(SLiveBlueprintInstanceTable::TabName);
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(SLiveBlueprintReplayViewer::TabName);
+	}
+
 	FEditorDelegates::OnSwitchBeginPIEAndSIE.Remove(OnSwitchBeginPIEAndSIEDelegateHandle);
 	FEditorDelegates::OnPreSwitchBeginPIEAndSIE.Remove(OnPreSwitchBeginPIEAndSIEDelegateHandle);
 	FEditorDelegates::PostPIEStarted.Remove(PostPIEStartedDelegateHandle);
 	FEditorDelegates::PreBeginPIE.Remove(PreBeginPIEDelegateHandle);
+
+	if (UObjectInitialized())
+	{
+		GetMutableDefault<ULiveBlueprintDebuggerSettings>()->OnSettingChanged().Remove(SettingsChangedDelegateHandle);
+	}
+
 	OnExtendActorDetails.Remove(DetailCustomizationDelegateHandle);
 	DetailCustomizationDelegateHandle.Reset();
-	CurrentDetailCustomization.Reset();
+	DetailCustomizations.Empty();
+	SelectionStateCache.Reset();
+	FLiveBlueprintUpdateDriver::Get().Shutdown();
+	FLiveBlueprintRecorder::Get().Stop();
+	FLiveBlueprintClassLayoutCache::Get().Shutdown();
 }
 
 void FLiveBlueprintDebuggerModule::SaveSelectedActor(bool bIsSimulating)
@@ -0,0 +1,514 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "LiveBlueprintDebuggerBenchmarkCommandlet.h"
+
+#include "Dom/JsonObject.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/UserDefinedStruct.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Kismet2/StructureEditorUtils.h"
+#include "LiveBlueprintClassLayout.h"
+#include "LiveBlueprintDebugger.h"
+#include "LiveBlueprintDebuggerDetailCustomization.h"
+#include "LiveBlueprintDebuggerSettings.h"
+#include "LiveBlueprintRowStore.h"
+#include "LiveBlueprintSelectionState.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+// The simulated frame rate. Rows are polled at the 30Hz refresh rate setting.
+static constexpr double c_FramePeriodInSeconds = 1.0 / 60.0;
+
+// Hashing is repeated until about this many rows have been hashed, so that the cost per row is
+// measured over a meaningful amount of time even for small classes.
+static constexpr int32 c_NumRowsToHash = 1'000'000;
+
+static FEdGraphPinType MakePinType(
+	const FName& Category,
+	const FName& SubCategory = NAME_None,
+	UObject* SubCategoryObject = nullptr,
+	EPinContainerType ContainerType = EPinContainerType::None)
+{
+	return FEdGraphPinType(Category, SubCategory, SubCategoryObject, ContainerType, false, FEdGraphTerminalType());
+}
+
+static FEdGraphPinType MakeFloatPinType()
+{
+#if ENGINE_MAJOR_VERSION == 5
+	return MakePinType(UEdGraphSchema_K2::PC_Real, UEdGraphSchema_K2::PC_Double);
+#else
+	return MakePinType(UEdGraphSchema_K2::PC_Float);
+#endif
+}
+
+static FEdGraphPinType MakeStructPinType(UScriptStruct* Struct)
+{
+	return MakePinType(UEdGraphSchema_K2::PC_Struct, NAME_None, Struct);
+}
+
+static double ToMicroseconds(double Seconds)
+{
+	return Seconds * 1'000'000.0;
+}
+
+ULiveBlueprintDebuggerBenchmarkCommandlet::ULiveBlueprintDebuggerBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 ULiveBlueprintDebuggerBenchmarkCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamsMap;
+	ParseCommandLine(*Params, Tokens, Switches, ParamsMap);
+
+	const TArray<int32> PropertyCounts = ParseIntegerList(ParamsMap, TEXT("Properties"), TEXT("100,1000"));
+	const TArray<int32> Depths = ParseIntegerList(ParamsMap, TEXT("Depth"), TEXT("0,3"));
+	const TArray<int32> ContainerSizes = ParseIntegerList(ParamsMap, TEXT("ContainerSize"), TEXT("0,1000"));
+	const FString* TicksParam = ParamsMap.Find(TEXT("Ticks"));
+	const FString* ChangeFractionParam = ParamsMap.Find(TEXT("ChangeFraction"));
+	const FString* PanelsParam = ParamsMap.Find(TEXT("Panels"));
+	const FString* VisibleRowsParam = ParamsMap.Find(TEXT("VisibleRows"));
+	const FString* BudgetParam = ParamsMap.Find(TEXT("Budget"));
+	const FString* SnapshotDiffingParam = ParamsMap.Find(TEXT("SnapshotDiffing"));
+	const FString* OutputParam = ParamsMap.Find(TEXT("Output"));
+
+	// The customizations read their settings when they are created. The budget defaults to unlimited
+	// so that every due row is polled and the full cost of a tick is measured. The settings are put
+	// back afterwards so that they are not saved with the benchmark's values.
+	ULiveBlueprintDebuggerSettings* Settings = GetMutableDefault<ULiveBlueprintDebuggerSettings>();
+	const EPropertyRefreshRate SavedRefreshRate = Settings->PropertyRefreshRate;
+	const int32 SavedBudgetMicroseconds = Settings->UpdateBudgetMicroseconds;
+	const bool bSavedSnapshotDiffing = Settings->bSnapshotDiffing;
+
+	Settings->PropertyRefreshRate = EPropertyRefreshRate::Thirty;
+	Settings->UpdateBudgetMicroseconds = (BudgetParam != nullptr) ? FMath::Max(FCString::Atoi(**BudgetParam), 0) : 0;
+	Settings->bSnapshotDiffing = (SnapshotDiffingParam != nullptr) && FCString::ToBool(**SnapshotDiffingParam);
+
+	const FString OutputPath = (OutputParam != nullptr) ?
+		*OutputParam :
+		FPaths::Combine(
+			FPaths::ProjectSavedDir(),
+			TEXT("LiveBlueprintDebugger"),
+			FString::Printf(TEXT("Benchmark-%s.json"), *FDateTime::Now().ToString()));
+
+	TArray<TSharedPtr<FJsonValue>> Results;
+
+	for (int32 NumProperties : PropertyCounts)
+	{
+		for (int32 Depth : Depths)
+		{
+			for (int32 ContainerSize : ContainerSizes)
+			{
+				FConfiguration Configuration;
+				Configuration.NumProperties = FMath::Max(NumProperties, 1);
+				Configuration.Depth = FMath::Max(Depth, 0);
+				Configuration.ContainerSize = FMath::Max(ContainerSize, 0);
+				Configuration.NumTicks = (TicksParam != nullptr) ? FMath::Max(FCString::Atoi(**TicksParam), 1) : 600;
+				Configuration.ChangeFraction = (ChangeFractionParam != nullptr) ?
+					FMath::Clamp(FCString::Atof(**ChangeFractionParam), 0.0f, 1.0f) :
+					0.05f;
+				Configuration.NumPanels = (PanelsParam != nullptr) ? FMath::Max(FCString::Atoi(**PanelsParam), 1) : 1;
+				Configuration.NumVisibleRows = (VisibleRowsParam != nullptr) ? 
+					FMath::Max(FCString::Atoi(**VisibleRowsParam), 0) : 
+					MAX_int32;
+
+				UE_LOG(
+					LogLiveBlueprintDebugger,
+					Display,
+					TEXT("Benchmarking %i properties, nesting depth %i, container size %i..."),
+					Configuration.NumProperties,
+					Configuration.Depth,
+					Configuration.ContainerSize);
+
+				Results.Add(MakeShared<FJsonValueObject>(RunConfiguration(Configuration)));
+
+				// Throw away the synthetic Blueprint before building the next one.
+				CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			}
+		}
+	}
+
+	const int32 BudgetMicroseconds = Settings->UpdateBudgetMicroseconds;
+	const bool bSnapshotDiffing = Settings->bSnapshotDiffing;
+
+	Settings->PropertyRefreshRate = SavedRefreshRate;
+	Settings->UpdateBudgetMicroseconds = SavedBudgetMicroseconds;
+	Settings->bSnapshotDiffing = bSavedSnapshotDiffing;
+
+	TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("LiveBlueprintDebugger"));
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("pluginVersion"), Plugin.IsValid() ? Plugin->GetDescriptor().VersionName : FString());
+	Root->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+	Root->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+	Root->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+	Root->SetNumberField(TEXT("budgetMicroseconds"), BudgetMicroseconds);
+	Root->SetBoolField(TEXT("snapshotDiffing"), bSnapshotDiffing);
+	Root->SetArrayField(TEXT("results"), Results);
+
+	FString Json;
+	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Root, JsonWriter);
+
+	if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+	{
+		UE_LOG(LogLiveBlueprintDebugger, Error, TEXT("Could not write benchmark results to '%s'."), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogLiveBlueprintDebugger, Display, TEXT("Wrote benchmark results to '%s'."), *OutputPath);
+	return 0;
+}
+
+TSharedRef<FJsonObject> ULiveBlueprintDebuggerBenchmarkCommandlet::RunConfiguration(const FConfiguration& Configuration)
+{
+	UBlueprint* Blueprint = CreateBlueprint(Configuration);
+	UClass* Class = Blueprint->GeneratedClass;
+
+	// The details panel only shows actors that are in a world, so the class is spawned into one that
+	// is never ticked. Time only moves forward when the benchmark sets it.
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	AActor* Actor = World->SpawnActor<AActor>(Class);
+
+	// The class layout is built the first time the class is selected, and is shared by every panel
+	// after that.
+	const double LayoutStartTime = FPlatformTime::Seconds();
+	TSharedRef<const FLiveBlueprintClassLayout> ClassLayout = FLiveBlueprintClassLayoutCache::Get().FindOrBuild(Class);
+	const double LayoutSeconds = FPlatformTime::Seconds() - LayoutStartTime;
+
+	// A row store of the benchmark's own is used to find the values to fill in and change, and to
+	// measure hashing on its own.
+	FLiveBlueprintRowStore Rows;
+	Rows.Initialize(*ClassLayout, 1, false);
+
+	FillContainers(Rows, Actor, Configuration.ContainerSize);
+
+	const int32 NumRows = Rows.Num();
+	TArray<int32> HashedRows;
+	TArray<int32> NumericRows;
+
+	for (int32 RowIndex = 0; RowIndex < NumRows; RowIndex++)
+	{
+		if (!Rows.IsGroupRow[RowIndex])
+		{
+			HashedRows.Add(RowIndex);
+		}
+
+		if (Rows.Properties[RowIndex]->IsA<FNumericProperty>())
+		{
+			NumericRows.Add(RowIndex);
+		}
+	}
+
+	// Construction: everything the details panel does when an Actor is selected, except for creating
+	// the widgets. Every panel after the first reuses the class layout and the shared reads.
+	const TArray<TWeakObjectPtr<AActor>> Actors{ Actor };
+	FLiveBlueprintSelectionStateCache StateCache;
+	TArray<TUniquePtr<FLiveBlueprintDebuggerDetailCustomization>> Customizations;
+
+	const double ConstructionStartTime = FPlatformTime::Seconds();
+
+	for (int32 PanelIndex = 0; PanelIndex < Configuration.NumPanels; PanelIndex++)
+	{
+		Customizations.Add(FLiveBlueprintDebuggerDetailCustomization::CreateWithoutWidgets(
+			Actors, 
+			StateCache, 
+			Configuration.NumVisibleRows));
+	}
+
+	const double ConstructionSeconds = FPlatformTime::Seconds() - ConstructionStartTime;
+
+	// Hashing.
+	const int32 NumHashPasses = FMath::Max(c_NumRowsToHash / FMath::Max(HashedRows.Num(), 1), 1);
+	uint32 HashSink = 0;
+	const double HashStartTime = FPlatformTime::Seconds();
+
+	for (int32 Pass = 0; Pass < NumHashPasses; Pass++)
+	{
+		for (int32 RowIndex : HashedRows)
+		{
+			HashSink ^= Rows.HashValue(RowIndex, Actor);
+		}
+	}
+
+	const double HashSeconds = FPlatformTime::Seconds() - HashStartTime;
+
+	// Per-tick updates, with a fraction of the numeric values changing between ticks. Every panel is
+	// updated in the same frame, like FLiveBlueprintUpdateDriver does. The frame counter is advanced
+	// by hand since the engine is not ticking, and the shared reads rely on it.
+	const int32 NumChangesPerTick = FMath::RoundToInt(Configuration.ChangeFraction * NumericRows.Num());
+	int32 ChangeCursor = 0;
+	int64 NumRowsPolled = 0;
+	int64 NumRowsChanged = 0;
+	int64 NumRowsSkipped = 0;
+	double FormatWaitSeconds = 0.0;
+	TArray<double> TickSeconds;
+	TickSeconds.Reserve(Configuration.NumTicks);
+
+	for (int32 Tick = 0; Tick < Configuration.NumTicks; Tick++)
+	{
+		ChangeValues(Rows, NumericRows, Actor, NumChangesPerTick, ChangeCursor);
+
+		GFrameCounter++;
+		World->RealTimeSeconds = static_cast<decltype(World->RealTimeSeconds)>((Tick + 1) * c_FramePeriodInSeconds);
+
+		const double TickStartTime = FPlatformTime::Seconds();
+
+		for (const TUniquePtr<FLiveBlueprintDebuggerDetailCustomization>& Customization : Customizations)
+		{
+			Customization->UpdateBlueprintDetails();
+		}
+
+		TickSeconds.Add(FPlatformTime::Seconds() - TickStartTime);
+
+		// The values are formatted on a worker thread while the game thread moves on to the next
+		// frame. Waiting for it here keeps the values from being changed while they are read, and
+		// measures how long the worker was still busy once the update returned.
+		const double FormatWaitStartTime = FPlatformTime::Seconds();
+
+		for (const TUniquePtr<FLiveBlueprintDebuggerDetailCustomization>& Customization : Customizations)
+		{
+			Customization->WaitForFormatting();
+
+			const FLiveBlueprintDebuggerDetailCustomization::FUpdateCounts& Counts = Customization->GetLastUpdateCounts();
+			NumRowsPolled += Counts.NumRowsPolled;
+			NumRowsChanged += Counts.NumRowsUpdated;
+			NumRowsSkipped += Counts.NumRowsSkipped;
+		}
+
+		FormatWaitSeconds += FPlatformTime::Seconds() - FormatWaitStartTime;
+	}
+
+	TickSeconds.Sort();
+
+	double TotalTickSeconds = 0.0;
+
+	for (double Seconds : TickSeconds)
+	{
+		TotalTickSeconds += Seconds;
+	}
+
+	const int32 NumTicks = TickSeconds.Num();
+	const SIZE_T AllocatedSize = Customizations[0]->GetAllocatedSize();
+
+	TSharedRef<FJsonObject> TickObject = MakeShared<FJsonObject>();
+	TickObject->SetNumberField(TEXT("meanMicroseconds"), ToMicroseconds(TotalTickSeconds / NumTicks));
+	TickObject->SetNumberField(TEXT("medianMicroseconds"), ToMicroseconds(TickSeconds[NumTicks / 2]));
+	TickObject->SetNumberField(TEXT("p95Microseconds"), ToMicroseconds(TickSeconds[FMath::Min(NumTicks * 95 / 100, NumTicks - 1)]));
+	TickObject->SetNumberField(TEXT("maxMicroseconds"), ToMicroseconds(TickSeconds.Last()));
+	TickObject->SetNumberField(TEXT("formatWaitMicroseconds"), ToMicroseconds(FormatWaitSeconds / NumTicks));
+	TickObject->SetNumberField(TEXT("rowsPolledPerTick"), static_cast<double>(NumRowsPolled) / NumTicks);
+	TickObject->SetNumberField(TEXT("rowsChangedPerTick"), static_cast<double>(NumRowsChanged) / NumTicks);
+	TickObject->SetNumberField(TEXT("rowsSkippedPerTick"), static_cast<double>(NumRowsSkipped) / NumTicks);
+
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetNumberField(TEXT("properties"), Configuration.NumProperties);
+	Result->SetNumberField(TEXT("depth"), Configuration.Depth);
+	Result->SetNumberField(TEXT("containerSize"), Configuration.ContainerSize);
+	Result->SetNumberField(TEXT("changeFraction"), Configuration.ChangeFraction);
+	Result->SetNumberField(TEXT("panels"), Configuration.NumPanels);
+	Result->SetNumberField(TEXT("visibleRows"), FMath::Min(Configuration.NumVisibleRows, NumRows));
+	Result->SetNumberField(TEXT("rows"), NumRows);
+	Result->SetNumberField(TEXT("layoutBuildMicroseconds"), ToMicroseconds(LayoutSeconds));
+	Result->SetNumberField(TEXT("customizationMicroseconds"), ToMicroseconds(ConstructionSeconds / Configuration.NumPanels));
+	Result->SetNumberField(TEXT("constructionMicroseconds"), ToMicroseconds(LayoutSeconds + ConstructionSeconds));
+	Result->SetNumberField(TEXT("hashNanosecondsPerRow"), HashSeconds * 1'000'000'000.0 / FMath::Max<int64>(int64(NumHashPasses) * HashedRows.Num(), 1));
+	Result->SetNumberField(TEXT("bytesPerRow"), static_cast<double>(AllocatedSize) / FMath::Max(NumRows, 1));
+	Result->SetObjectField(TEXT("tick"), TickObject);
+
+	// Keeps the hashing loop from being optimized away.
+	Result->SetNumberField(TEXT("hashChecksum"), HashSink);
+
+	// The customizations have to go before the world they read from.
+	Customizations.Empty();
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+
+	return Result;
+}
+
+UBlueprint* ULiveBlueprintDebuggerBenchmarkCommandlet::CreateBlueprint(const FConfiguration& Configuration)
+{
+	UUserDefinedStruct* NestedStruct = (Configuration.Depth > 0) ? CreateNestedStruct(Configuration.Depth) : nullptr;
+
+	UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(
+		AActor::StaticClass(),
+		GetTransientPackage(),
+		MakeUniqueObjectName(GetTransientPackage(), UBlueprint::StaticClass(), TEXT("LiveBlueprintBenchmark")),
+		BPTYPE_Normal,
+		UBlueprint::StaticClass(),
+		UBlueprintGeneratedClass::StaticClass());
+
+	// A mix of variable types roughly like a gameplay Blueprint: mostly numbers, some bools,
+	// strings, and vectors, plus nested structs and arrays when they are being measured.
+	for (int32 PropertyIndex = 0; PropertyIndex < Configuration.NumProperties; PropertyIndex++)
+	{
+		FEdGraphPinType PinType;
+
+		switch (PropertyIndex % 10)
+		{
+			case 0:
+			{
+				PinType = (NestedStruct != nullptr) ? MakeStructPinType(NestedStruct) : MakeFloatPinType();
+				break;
+			}
+
+			case 2:
+			case 8:
+			{
+				PinType = MakePinType(UEdGraphSchema_K2::PC_Int);
+				break;
+			}
+
+			case 3:
+			{
+				PinType = MakePinType(UEdGraphSchema_K2::PC_Boolean);
+				break;
+			}
+
+			case 5:
+			{
+				PinType = MakePinType(
+					UEdGraphSchema_K2::PC_Int,
+					NAME_None,
+					nullptr,
+					(Configuration.ContainerSize > 0) ? EPinContainerType::Array : EPinContainerType::None);
+				break;
+			}
+
+			case 6:
+			{
+				PinType = MakePinType(UEdGraphSchema_K2::PC_String);
+				break;
+			}
+
+			case 9:
+			{
+				PinType = MakeStructPinType(TBaseStructure<FVector>::Get());
+				break;
+			}
+
+			default:
+			{
+				PinType = MakeFloatPinType();
+				break;
+			}
+		}
+
+		FBlueprintEditorUtils::AddMemberVariable(Blueprint, *FString::Printf(TEXT("Variable%i"), PropertyIndex), PinType);
+	}
+
+	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	return Blueprint;
+}
+
+UUserDefinedStruct* ULiveBlueprintDebuggerBenchmarkCommandlet::CreateNestedStruct(int32 Depth)
+{
+	UUserDefinedStruct* InnerStruct = nullptr;
+
+	for (int32 Level = 0; Level < Depth; Level++)
+	{
+		UUserDefinedStruct* Struct = FStructureEditorUtils::CreateUserDefinedStruct(
+			GetTransientPackage(),
+			MakeUniqueObjectName(GetTransientPackage(), UUserDefinedStruct::StaticClass(), TEXT("LiveBlueprintBenchmarkStruct")),
+			RF_Transient);
+
+		FStructureEditorUtils::AddVariable(Struct, MakeFloatPinType());
+		FStructureEditorUtils::AddVariable(Struct, MakePinType(UEdGraphSchema_K2::PC_Int));
+		FStructureEditorUtils::AddVariable(Struct, MakeStructPinType(TBaseStructure<FVector>::Get()));
+
+		if (InnerStruct != nullptr)
+		{
+			FStructureEditorUtils::AddVariable(Struct, MakeStructPinType(InnerStruct));
+		}
+
+		InnerStruct = Struct;
+	}
+
+	return InnerStruct;
+}
+
+void ULiveBlueprintDebuggerBenchmarkCommandlet::FillContainers(
+	const FLiveBlueprintRowStore& Rows,
+	UObject* Object,
+	int32 ContainerSize)
+{
+	for (int32 RowIndex = 0; RowIndex < Rows.Num(); RowIndex++)
+	{
+		const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Rows.Properties[RowIndex]);
+		const FNumericProperty* InnerProperty = (ArrayProperty != nullptr) ? CastField<FNumericProperty>(ArrayProperty->Inner) : nullptr;
+
+		if (InnerProperty == nullptr)
+		{
+			continue;
+		}
+
+		FScriptArrayHelper ArrayHelper(ArrayProperty, Rows.GetValuePointer(RowIndex, Object));
+		ArrayHelper.Resize(ContainerSize);
+
+		for (int32 ElementIndex = 0; ElementIndex < ContainerSize; ElementIndex++)
+		{
+			InnerProperty->SetIntPropertyValue(ArrayHelper.GetRawPtr(ElementIndex), static_cast<int64>(ElementIndex));
+		}
+	}
+}
+
+void ULiveBlueprintDebuggerBenchmarkCommandlet::ChangeValues(
+	const FLiveBlueprintRowStore& Rows,
+	const TArray<int32>& NumericRows,
+	UObject* Object,
+	int32 NumChanges,
+	int32& Cursor)
+{
+	for (int32 ChangeIndex = 0; ChangeIndex < NumChanges && NumericRows.Num() > 0; ChangeIndex++)
+	{
+		const int32 RowIndex = NumericRows[Cursor];
+		const FNumericProperty* NumericProperty = CastFieldChecked<FNumericProperty>(Rows.Properties[RowIndex]);
+		void* ValuePointer = Rows.GetValuePointer(RowIndex, Object);
+
+		if (NumericProperty->IsFloatingPoint())
+		{
+			NumericProperty->SetFloatingPointPropertyValue(ValuePointer, NumericProperty->GetFloatingPointPropertyValue(ValuePointer) + 1.0);
+		}
+		else
+		{
+			NumericProperty->SetIntPropertyValue(ValuePointer, NumericProperty->GetSignedIntPropertyValue(ValuePointer) + 1);
+		}
+
+		Cursor = (Cursor + 1) % NumericRows.Num();
+	}
+}
+
+TArray<int32> ULiveBlueprintDebuggerBenchmarkCommandlet::ParseIntegerList(
+	const TMap<FString, FString>& ParamsMap,
+	const TCHAR* Key,
+	const TCHAR* DefaultValue)
+{
+	const FString* Value = ParamsMap.Find(Key);
+	TArray<FString> Entries;
+	((Value != nullptr) ? *Value : FString(DefaultValue)).ParseIntoArray(Entries, TEXT(","));
+
+	TArray<int32> Integers;
+
+	for (const FString& Entry : Entries)
+	{
+		Integers.Add(FCString::Atoi(*Entry));
+	}
+
+	return Integers;
+}
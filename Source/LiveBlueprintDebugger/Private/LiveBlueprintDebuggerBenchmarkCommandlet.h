@@ -0,0 +1,57 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "LiveBlueprintDebuggerBenchmarkCommandlet.generated.h"
+
+class UBlueprint;
+class UUserDefinedStruct;
+struct FLiveBlueprintRowStore;
+
+// Benchmarks the hot paths of the debugger on synthetic Blueprint classes and writes the results
+// as JSON, so that performance can be compared between versions of the plugin. Runs headless:
+//
+//   UnrealEditor-Cmd <Project> -run=LiveBlueprintDebuggerBenchmark -nullrhi -unattended
+//       [-Properties=100,1000] [-Depth=0,3] [-ContainerSize=0,1000] [-Ticks=600]
+//       [-ChangeFraction=0.05] [-Panels=1] [-VisibleRows=<all>] [-Budget=0]
+//       [-SnapshotDiffing=false] [-Output=<path>]
+//
+// Every combination of the comma-separated Properties, Depth, and ContainerSize values is measured
+// on a freshly compiled Blueprint class. An instance of the class is spawned in a new world and
+// shown in Panels customizations created with CreateWithoutWidgets, whose UpdateBlueprintDetails
+// is called once per simulated frame, so the scheduler, snapshot diffing, shared reads, and worker
+// formatting all run exactly like they do in the editor. The Slate widgets of the details panel
+// can't be created without a renderer, so setting widget text and highlights is not measured, and
+// visibility is simulated by treating the first VisibleRows rows as scrolled into view.
+UCLASS()
+class ULiveBlueprintDebuggerBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	ULiveBlueprintDebuggerBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	struct FConfiguration
+	{
+		int32 NumProperties = 0;
+		int32 Depth = 0;
+		int32 ContainerSize = 0;
+		int32 NumTicks = 0;
+		float ChangeFraction = 0.0f;
+		int32 NumPanels = 0;
+		int32 NumVisibleRows = 0;
+	};
+
+	static TSharedRef<class FJsonObject> RunConfiguration(const FConfiguration& Configuration);
+	static UBlueprint* CreateBlueprint(const FConfiguration& Configuration);
+	static UUserDefinedStruct* CreateNestedStruct(int32 Depth);
+	static void FillContainers(const FLiveBlueprintRowStore& Rows, UObject* Object, int32 ContainerSize);
+	static void ChangeValues(const FLiveBlueprintRowStore& Rows, const TArray<int32>& NumericRows, UObject* Object, int32 NumChanges, int32& Cursor);
+	static TArray<int32> ParseIntegerList(const TMap<FString, FString>& ParamsMap, const TCHAR* Key, const TCHAR* DefaultValue);
+};
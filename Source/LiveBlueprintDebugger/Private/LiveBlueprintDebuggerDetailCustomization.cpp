@@ -5,33 +5,39 @@
 #include <algorithm>
 #include <chrono>
 #include "BlueprintEditor.h"
+#include "ContainerElementHelper.h"
 #include "DetailCategoryBuilder.h"
 #include "DetailLayoutBuilder.h"
 #include "DetailWidgetRow.h"
+#include "Framework/Application/SlateApplication.h"
 #include "IDetailGroup.h"
-#include "Brushes/SlateColorBrush.h"
+#include "IDetailsView.h"
 #include "Kismet2/KismetDebugUtilities.h"
+#include "LiveBlueprintClassLayout.h"
 #include "LiveBlueprintDebugger.h"
+#include "LiveBlueprintDebuggerStats.h"
 #include "LiveBlueprintDebuggerSettings.h"
+#include "LiveBlueprintRecorder.h"
+#include "SLiveBlueprintSparkline.h"
+#include "SLiveBlueprintValueWidget.h"
+#include "Widgets/SBoxPanel.h"
 #include "Widgets/Text/STextBlock.h"
 
 #define LOCTEXT_NAMESPACE "FLiveBlueprintDebuggerModule"
 
-static const FString c_PrivateCategoryName = "Private Implementation Variables";
-static const FSlateColorBrush c_HighlightedBackgroundBrush = FSlateColorBrush(FLinearColor::White);
-
 
 TUniquePtr<FLiveBlueprintDebuggerDetailCustomization> FLiveBlueprintDebuggerDetailCustomization::CreateForLayoutBuilder(
-	IDetailLayoutBuilder& LayoutBuilder)
+	IDetailLayoutBuilder& LayoutBuilder,
+	FLiveBlueprintSelectionStateCache& StateCache)
 {
-	TWeakObjectPtr<AActor> Actor = GetActorToCustomize(LayoutBuilder);
+	TArray<TWeakObjectPtr<AActor>> Actors = GetActorsToCustomize(LayoutBuilder);
 
-    if (Actor == nullptr)
+    if (Actors.Num() == 0)
     {
         return nullptr;
     }
 
-    if (!IsAnyAncestorABlueprintClass(Actor->GetClass()))
+    if (!IsAnyAncestorABlueprintClass(Actors[0]->GetClass()))
     {
         return nullptr;
     }
@@ -49,11 +55,36 @@ TUniquePtr<FLiveBlueprintDebuggerDetailCustomization> FLiveBlueprintDebuggerDeta
 		return nullptr;
 	}
 
+	// The categorized property layout only depends on the class, so it is shared between all
+	// instances of the class that get selected. Everything else is only kept across rebuilds of the
+	// details panel while live updates keep it up-to-date.
+	TSharedRef<const FLiveBlueprintClassLayout> ClassLayout = 
+		FLiveBlueprintClassLayoutCache::Get().FindOrBuild(Actors[0]->GetClass());
+
+	TSharedRef<FLiveBlueprintSelectionState> State = StateCache.Acquire(
+		Actors, 
+		ClassLayout, 
+		HasLiveUpdates(Actors[0]->GetWorld()));
+
+	return TUniquePtr<FLiveBlueprintDebuggerDetailCustomization>(
+		new FLiveBlueprintDebuggerDetailCustomization{Actors, LayoutBuilder, State});
+}
+
+TUniquePtr<FLiveBlueprintDebuggerDetailCustomization> FLiveBlueprintDebuggerDetailCustomization::CreateWithoutWidgets(
+	const TArray<TWeakObjectPtr<AActor>>& Actors,
+	FLiveBlueprintSelectionStateCache& StateCache,
+	int32 NumRowsShown)
+{
+	TSharedRef<const FLiveBlueprintClassLayout> ClassLayout = 
+		FLiveBlueprintClassLayoutCache::Get().FindOrBuild(Actors[0]->GetClass());
+
+	TSharedRef<FLiveBlueprintSelectionState> State = StateCache.Acquire(Actors, ClassLayout, false);
+
 	return TUniquePtr<FLiveBlueprintDebuggerDetailCustomization>(
-		new FLiveBlueprintDebuggerDetailCustomization{Actor, LayoutBuilder});
+		new FLiveBlueprintDebuggerDetailCustomization{Actors, State, NumRowsShown});
 }
 
-TWeakObjectPtr<AActor> FLiveBlueprintDebuggerDetailCustomization::GetActorToCustomize(IDetailLayoutBuilder& LayoutBuilder)
+TArray<TWeakObjectPtr<AActor>> FLiveBlueprintDebuggerDetailCustomization::GetActorsToCustomize(IDetailLayoutBuilder& LayoutBuilder)
 {
     TArray<TWeakObjectPtr<UObject>> ObjectsBeingCustomized;
     LayoutBuilder.GetObjectsBeingCustomized(ObjectsBeingCustomized);
@@ -65,32 +96,47 @@ TWeakObjectPtr<AActor> FLiveBlueprintDebuggerDetailCustomization::GetActorToCust
             Display,
             TEXT("No objects selected."));
 
-        return nullptr;
+        return {};
     }
 
-    if (ObjectsBeingCustomized.Num() > 1)
-    {
-        UE_LOG(
-            LogLiveBlueprintDebugger,
-            Display,
-            TEXT("Blueprint details only support one object."));
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	Actors.Reserve(ObjectsBeingCustomized.Num());
 
-        return nullptr;
-    }
+	for (const TWeakObjectPtr<UObject>& Object : ObjectsBeingCustomized)
+	{
+		if (!Object.IsValid())
+		{
+			UE_LOG(
+				LogLiveBlueprintDebugger,
+				Display,
+				TEXT("Selected object is invalid."));
 
-    auto Object = ObjectsBeingCustomized[0];
+			return {};
+		}
 
-    if (!Object.IsValid())
-    {
-        UE_LOG(
-            LogLiveBlueprintDebugger,
-            Display,
-            TEXT("Selected object is invalid."));
+		// All of the selected actors share one class layout, so they need to have the same class.
+		if (Object->GetClass() != ObjectsBeingCustomized[0]->GetClass())
+		{
+			UE_LOG(
+				LogLiveBlueprintDebugger,
+				Display,
+				TEXT("Blueprint details only support selecting objects of the same class."));
 
-        return nullptr;
-    }
+			return {};
+		}
+
+		Actors.Add(TWeakObjectPtr<AActor>(CastChecked<AActor>(Object)));
+	}
 	
-    return TWeakObjectPtr<AActor>(CastChecked<AActor>(Object));
+    return Actors;
+}
+
+bool FLiveBlueprintDebuggerDetailCustomization::HasLiveUpdates(const UWorld* World)
+{
+	return (
+		World != nullptr &&
+		World->WorldType == EWorldType::PIE &&
+		GetDefault<ULiveBlueprintDebuggerSettings>()->PropertyRefreshRate != EPropertyRefreshRate::NoLiveUpdates);
 }
 
 bool FLiveBlueprintDebuggerDetailCustomization::IsAnyAncestorABlueprintClass(UClass* Class)
@@ -109,29 +155,33 @@ bool FLiveBlueprintDebuggerDetailCustomization::IsAnyAncestorABlueprintClass(UCl
 }
 
 FLiveBlueprintDebuggerDetailCustomization::FLiveBlueprintDebuggerDetailCustomization(
-	TWeakObjectPtr<AActor> ActorToCustomize,
-	IDetailLayoutBuilder& LayoutBuilder) :
-		Actor(ActorToCustomize)
+	const TArray<TWeakObjectPtr<AActor>>& ActorsToCustomize,
+	IDetailLayoutBuilder& LayoutBuilder,
+	const TSharedRef<FLiveBlueprintSelectionState>& InState) :
+		Actors(ActorsToCustomize),
+		World(ActorsToCustomize[0]->GetWorld()),
+		ClassLayout(InState->ClassLayout),
+		State(InState),
+		bRebindWidgets(InState->bIsInitialized),
+		bHasWidgets(true)
 {
+	LIVE_BLUEPRINT_SCOPE(Construct);
+
 	UE_LOG(
 		LogLiveBlueprintDebugger,
 		Verbose,
-		TEXT("Customizing Actor '%s'..."),
-		*Actor->GetName());
+		TEXT("Customizing Actor '%s' and %i other Actors%s..."),
+		*Actors[0]->GetName(),
+		Actors.Num() - 1,
+		bRebindWidgets ? TEXT(" with cached rows") : TEXT(""));
 
-	// Categorize and sort the properties associated with this Blueprint class.
-	TMap<FString, TArray<FFastPropertyInstanceInfo>> PropertiesByCategory;
-	for (auto Iterator = TFieldIterator<FProperty>(Actor->GetClass()); Iterator != nullptr; ++Iterator)
-	{
-		FProperty* Property = *Iterator;
+	ResolveActors();
 
-		if (Property->HasAllPropertyFlags(CPF_BlueprintVisible))
-		{
-			PropertiesByCategory.FindOrAdd(GetPropertyCategoryString(Property)).Add(
-				{ 
-					FFastPropertyInstanceInfo(Actor.Get(), Property)
-				});
-		}
+	DetailsViewKey = LayoutBuilder.GetDetailsView();
+
+	if (DetailsViewKey != nullptr)
+	{
+		DetailsView = DetailsViewKey->AsShared();
 	}
 
 #if ENGINE_MAJOR_VERSION == 5
@@ -140,421 +190,1720 @@ FLiveBlueprintDebuggerDetailCustomization::FLiveBlueprintDebuggerDetailCustomiza
 	TSharedRef<FPropertySection> BlueprintSection = PropertyModule.FindOrCreateSection("Actor", "Blueprint", LOCTEXT("BlueprintSection", "Blueprint"));
 #endif
 
-	// Add widgets for all of the categories and properties.
-	for (auto& [CategoryString, PropertyInfoArray] : PropertiesByCategory)
+	const ULiveBlueprintDebuggerSettings* Settings = GetDefault<ULiveBlueprintDebuggerSettings>();
+	const bool bHasLiveUpdates = HasLiveUpdates(World.Get());
+
+	// A cached state only needs new widgets. Its rows were kept up-to-date until the previous
+	// customization went away, but they are not polled while the state sits in the cache, so every
+	// row is polled again on the first update to pick up anything that changed since.
+	if (!bRebindWidgets)
+	{
+		InitializeState(bHasLiveUpdates);
+	}
+	else
+	{
+		State->Scheduler.MarkAllDue(World->GetRealTimeSeconds());
+	}
+
+	// The rows that values are formatted on a worker thread for are formatted the same way when
+	// they are first filled in, so the formatter needs to be ready before that.
+	if (bHasLiveUpdates)
+	{
+		ValueFormatter.Initialize(State->Rows);
+	}
+
+	State->ValueHistory->SetCurrentTime(World->GetRealTimeSeconds());
+	const TArray<FLiveBlueprintPropertyLayout>& PropertyLayouts = ClassLayout->GetProperties();
+
+	// The overhead row shows what the debugger itself costs for this selection, so that the refresh
+	// rate can be lowered when selecting a heavy Actor makes it expensive.
+	if (bHasLiveUpdates && Settings->bShowDebuggerOverhead)
 	{
-		FName CategoryName = *FString::Printf(TEXT("Blueprint Properties - %s"), *CategoryString);
+		const FName OverheadCategoryName = TEXT("LiveBlueprintDebugger");
+		const FText OverheadRowName = LOCTEXT("OverheadRowName", "Debugger Cost");
+
+#if ENGINE_MAJOR_VERSION == 5
+		if (!BlueprintSection->HasAddedCategory(OverheadCategoryName))
+		{
+			BlueprintSection->AddCategory(OverheadCategoryName);
+		}
+#endif
 
+		OverheadSamples.SetNum(NumOverheadSamples);
+
+		LayoutBuilder.EditCategory(OverheadCategoryName, LOCTEXT("OverheadCategory", "Live Blueprint Debugger"), ECategoryPriority::Important)
+			.AddCustomRow(OverheadRowName)
+			.NameContent()
+			[
+				GenerateNameWidget(OverheadRowName)
+			]
+			.ValueContent()
+			[
+				SAssignNew(OverheadTextBlock, STextBlock)
+				.Text(LOCTEXT("OverheadWaiting", "Waiting for the first update..."))
+				.ToolTipText(LOCTEXT("OverheadToolTip", "The time spent updating the Blueprint variables of the selected Actors, the number of variables per update that were checked and changed or skipped because they were scrolled out of view, and the memory used to track them."))
+			];
+	}
+
+	// Add widgets for all of the categories and properties.
+	for (const FLiveBlueprintCategoryLayout& Category : ClassLayout->GetCategories())
+	{
 #if ENGINE_MAJOR_VERSION == 5
-		if (!BlueprintSection->HasAddedCategory(CategoryName))
+		if (!BlueprintSection->HasAddedCategory(Category.CategoryName))
 		{
-			BlueprintSection->AddCategory(CategoryName);
+			BlueprintSection->AddCategory(Category.CategoryName);
 		}
 #endif
 
-		IDetailCategoryBuilder& BlueprintCategory = LayoutBuilder.EditCategory(CategoryName);
+		IDetailCategoryBuilder& BlueprintCategory = LayoutBuilder.EditCategory(Category.CategoryName);
 		
-		for (auto& PropertyInstanceInfo : PropertyInfoArray)
+		for (int32 RowIndex = Category.FirstPropertyIndex; 
+			RowIndex < Category.FirstPropertyIndex + Category.NumProperties; 
+			RowIndex++)
 		{
-			if (FFastPropertyInstanceInfo::ShouldExpandProperty(PropertyInstanceInfo))
+			const FLiveBlueprintPropertyLayout& PropertyLayout = PropertyLayouts[RowIndex];
+
+			// Nested struct members are filled in by ExpandPropertyChildren.
+			if (PropertyLayout.ParentIndex != INDEX_NONE)
+			{
+				continue;
+			}
+
+			if (PropertyLayout.bIsGroup)
 			{
 				ExpandPropertyChildren(
 					BlueprintCategory.AddGroup(
-						PropertyInstanceInfo.GetProperty()->GetFName(),
-						PropertyInstanceInfo.GetDisplayName()),
-					PropertyInstanceInfo);
+						PropertyLayout.Property->GetFName(),
+						PropertyLayout.DisplayName),
+					RowIndex);
 			}
 			else
 			{
-				const bool bAdvancedDisplay =
-					PropertyInstanceInfo.GetProperty()->HasAnyPropertyFlags(CPF_AdvancedDisplay) ||
-					(CategoryString == c_PrivateCategoryName);
-
-				FLiveBlueprintWidgetRowData NewRowData { PropertyInstanceInfo };
-
 				FillInWidgetRow(
-					BlueprintCategory.AddCustomRow(PropertyInstanceInfo.GetProperty()->GetDisplayNameText(), bAdvancedDisplay),
-					NewRowData,
-					0);
-
-				WidgetRows.Add(NewRowData);
+					BlueprintCategory.AddCustomRow(PropertyLayout.DisplayName, PropertyLayout.bAdvancedDisplay),
+					RowIndex);
 			}
 		}
 	}
 
-	const ULiveBlueprintDebuggerSettings* Settings = GetDefault<ULiveBlueprintDebuggerSettings>();
-
-	// Register a timer to keep our values up-to-date.
-	if (Actor->GetWorld()->WorldType == EWorldType::PIE &&
-		Settings->PropertyRefreshRate != EPropertyRefreshRate::NoLiveUpdates)
+	// Register with the update driver to keep our values up-to-date.
+	if (bHasLiveUpdates)
 	{
-		float RefreshPeriod = 1.0f;
+		FLiveBlueprintUpdateDriver::Get().Register(this);
+		bIsRegisteredForUpdates = true;
+	}
 
-		switch (Settings->PropertyRefreshRate)
-		{
-			default:
-			case EPropertyRefreshRate::One:
-			{
-				RefreshPeriod = 1.0f;
-				break;
-			}
+	State->bIsInitialized = true;
+	UpdateMemoryStats();
+}
 
-			case EPropertyRefreshRate::Ten:
-			{
-				RefreshPeriod = 0.1f;
-				break;
-			}
+FLiveBlueprintDebuggerDetailCustomization::FLiveBlueprintDebuggerDetailCustomization(
+	const TArray<TWeakObjectPtr<AActor>>& ActorsToCustomize,
+	const TSharedRef<FLiveBlueprintSelectionState>& InState,
+	int32 NumRowsShown) :
+		Actors(ActorsToCustomize),
+		World(ActorsToCustomize[0]->GetWorld()),
+		ClassLayout(InState->ClassLayout),
+		State(InState),
+		bRebindWidgets(false),
+		bHasWidgets(false),
+		NumRowsShownWithoutWidgets(NumRowsShown)
+{
+	LIVE_BLUEPRINT_SCOPE(Construct);
 
-			case EPropertyRefreshRate::Thirty:
-			{
-				RefreshPeriod = 0.0334f;
-				break;
-			}
+	// This does everything the details panel does except for creating the rows and their widgets.
+	// Rows are filled in, or left pending, exactly like they would be in a details panel that has
+	// live updates.
+	ResolveActors();
+	InitializeState(true);
+	ValueFormatter.Initialize(State->Rows);
+	State->ValueHistory->SetCurrentTime(World->GetRealTimeSeconds());
+
+	for (int32 RowIndex = 0; RowIndex < State->Rows.Num(); RowIndex++)
+	{
+		if (State->PendingRows[RowIndex])
+		{
+			continue;
 		}
 
-		Actor->GetWorldTimerManager().SetTimer(
-			UpdateTimerHandle,
-			[this]()
-			{
-				UpdateBlueprintDetails();
-			},
-			RefreshPeriod,
-			true);
+		for (int32 InstanceIndex = 0; InstanceIndex < State->Rows.NumInstances(); InstanceIndex++)
+		{
+			FillInWidgetCell(RowIndex, InstanceIndex, State->ValueHistory->GetCurrentTime());
+		}
 	}
+
+	State->bIsInitialized = true;
+	UpdateMemoryStats();
 }
 
 FLiveBlueprintDebuggerDetailCustomization::~FLiveBlueprintDebuggerDetailCustomization()
 {
-	if (Actor.IsValid() && UpdateTimerHandle.IsValid())
+	if (bIsRegisteredForUpdates)
 	{
-		Actor->GetWorldTimerManager().ClearTimer(UpdateTimerHandle);
+		FLiveBlueprintUpdateDriver::Get().Unregister(this);
 	}
-}
 
-void FLiveBlueprintDebuggerDetailCustomization::UpdateBlueprintDetails()
-{
-	if (!Actor.IsValid())
+	// The state may be cached for the next customization of the same actors, which binds its own
+	// widgets to the value text kept in the state. Values that are still being formatted are
+	// finished first, unless the properties they belong to are already gone.
+	if (ClassLayout->IsStale())
 	{
-		return;
+		ValueFormatter.Cancel();
+	}
+	else
+	{
+		ValueFormatter.Flush(
+			[this](int32 CellIndex, const FText& ValueText)
+			{
+				State->ValueTexts[CellIndex] = ValueText;
+			});
 	}
 
-	double RealTimeInSeconds = Actor->GetWorld()->GetRealTimeSeconds();
-
-	for (auto& Row : WidgetRows)
+	// The widgets can outlive this customization until the details panel is rebuilt, so they must
+	// not call back into it.
+	for (TSharedPtr<SLiveBlueprintValueWidget>& ValueWidget : State->Rows.ValueWidgets)
 	{
-		UpdateWidgetRow(Row, RealTimeInSeconds);
+		if (ValueWidget.IsValid())
+		{
+			ValueWidget->SetOnExpanderClicked(FOnLiveBlueprintExpanderClicked());
+			ValueWidget->SetOnPageChanged(FOnLiveBlueprintPageChanged());
+		}
+
+		ValueWidget.Reset();
 	}
-}
 
-void FLiveBlueprintDebuggerDetailCustomization::ExpandPropertyChildren(
-	IDetailGroup& Group,
-	FFastPropertyInstanceInfo& PropertyInstanceInfo,
-	int LevelsOfRecursion)
-{
-	// Fill in the group's header row.
-	FLiveBlueprintWidgetRowData HeaderRowData {PropertyInstanceInfo};
-	FillInWidgetRow(Group.HeaderRow(), HeaderRowData, LevelsOfRecursion * 2 + 2);
-	WidgetRows.Add(HeaderRowData);
-
-	for (auto& ChildPropertyInfo : PropertyInstanceInfo.GetChildren())
-	{
-        if (FFastPropertyInstanceInfo::ShouldExpandProperty(ChildPropertyInfo) && LevelsOfRecursion < 5)
-        {
-            IDetailGroup& SubGroup = Group.AddGroup(
-				ChildPropertyInfo.GetProperty()->GetFName(),
-				ChildPropertyInfo.GetDisplayName(),
-                false);
-
-			ExpandPropertyChildren(
-				SubGroup,
-				ChildPropertyInfo,
-				LevelsOfRecursion + 1);
-        }
-        else
-        {
-			FLiveBlueprintWidgetRowData NewRowData { ChildPropertyInfo };
-			FillInWidgetRow(Group.AddWidgetRow(), NewRowData, LevelsOfRecursion * 2 + 2);
-			WidgetRows.Add(NewRowData);
-        }
-    }
+	State->bIsInUse = false;
 }
 
-void FLiveBlueprintDebuggerDetailCustomization::FillInWidgetRow(
-	FDetailWidgetRow& WidgetRow,
-	FLiveBlueprintWidgetRowData& WidgetRowData,
-	int LogIndentation)
+void FLiveBlueprintDebuggerDetailCustomization::InitializeState(bool bHasLiveUpdates)
 {
-	WidgetRowData.ValueHash = WidgetRowData.PropertyInstanceInfo.GetValueHash();
+	const ULiveBlueprintDebuggerSettings* Settings = GetDefault<ULiveBlueprintDebuggerSettings>();
 
-	FString Indentation = std::wstring(LogIndentation, L' ').c_str();
+	State->Rows.Initialize(*ClassLayout, Actors.Num(), bHasLiveUpdates && Settings->bShowValueHistory);
+	State->ValueHistory->Initialize(State->Rows.NumHistorySlots, Settings->ValueHistorySamples);
+	State->ValueTexts.SetNum(State->Rows.ValueWidgets.Num());
 
-    UE_LOG(
-        LogLiveBlueprintDebugger,
-		Verbose,
-        TEXT("%sProperty: '%s' [%s] \tFlags: 0x%08X\tHash: %i"),
-		*Indentation,
-        *WidgetRowData.PropertyInstanceInfo.GetProperty()->GetName(),
-        *WidgetRowData.PropertyInstanceInfo.GetProperty()->GetClass()->GetName(),
-		WidgetRowData.PropertyInstanceInfo.GetProperty()->GetPropertyFlags(),
-		WidgetRowData.ValueHash);
+	// Other panels that show the same actors share their reads with this one.
+	State->SharedReads.SetNum(Actors.Num());
 
-	WidgetRow
-		.NameContent()
-		[
-			SNew(SHorizontalBox)
-			
-			+ SHorizontalBox::Slot()
-			.AutoWidth()
-			.HAlign(HAlign_Left)
-			.VAlign(VAlign_Center)
-			[
-				GenerateNameIcon(WidgetRowData.PropertyInstanceInfo)
-			]
-			
-			+ SHorizontalBox::Slot()
-			.AutoWidth()
-			.HAlign(HAlign_Left)
-			.VAlign(VAlign_Center)
-			.Padding(5.f, 0.f, 0.f, 0.f)
-			[
-				GenerateNameWidget(WidgetRowData.PropertyInstanceInfo)
-			]
-		]
-		.ValueContent()
-		[
-			SAssignNew(WidgetRowData.ValueBorderWidget, SBorder)
-			.HAlign(EHorizontalAlignment::HAlign_Fill)
-			.VAlign(EVerticalAlignment::VAlign_Fill)
-			.BorderBackgroundColor(FColor::Transparent)
-			.BorderImage(&c_HighlightedBackgroundBrush)
-			.Content()
-			[
-				SAssignNew(WidgetRowData.ValueWidgetContainer, SHorizontalBox)
+	for (int32 InstanceIndex = 0; InstanceIndex < Actors.Num(); InstanceIndex++)
+	{
+		if (ResolvedActors[InstanceIndex] != nullptr)
+		{
+			State->SharedReads[InstanceIndex] = FLiveBlueprintUpdateDriver::Get().FindOrAddSharedReads(
+				*ClassLayout, 
+				ResolvedActors[InstanceIndex]);
+		}
+	}
 
-				+ SHorizontalBox::Slot()
-				.AutoWidth()
-				.HAlign(HAlign_Left)
-				.Padding(.5f, 1.f)
-			]
-		];
+	// With live updates, the values of struct members are filled in by the update driver once their
+	// rows are first shown, rather than all at once when the Actor is selected. Members that are 
+	// never polled because their refresh rate is overridden to 0 are still filled in right away.
+	// Pending members are only hashed up front, which is cheap, so that the summary in the header of
+	// their group still notices when they change.
+	State->PendingRows.Init(false, State->Rows.Num());
 
-	UpdateWidgetRowValue(WidgetRowData);
-}
+	if (!bHasLiveUpdates)
+	{
+		return;
+	}
 
-TSharedRef<SWidget> FLiveBlueprintDebuggerDetailCustomization::GenerateNameIcon(
-	const FFastPropertyInstanceInfo& PropertyInstanceInfo)
-{
-	// Unreal 5.1 has a bug where calling FDebugLineItem::GetNameIcon will crash if the given 
-	// property falls back to the default icon. So instead of relying on this, we create our 
-	// own icon in a similar way to the Kismet / Blueprint Debugger here.
-	
-	FSlateColor BaseColor;
-	FSlateColor UnusedColor;
-	FSlateBrush const* UnusedIcon = nullptr;
-	const FSlateBrush* IconBrush = FBlueprintEditor::GetVarIconAndColorFromProperty(
-		PropertyInstanceInfo.GetProperty().Get(),
-		BaseColor,
-		UnusedIcon,
-		UnusedColor
-	);
+	for (int32 RowIndex = 0; RowIndex < State->Rows.Num(); RowIndex++)
+	{
+		const float* RefreshRateOverride = FindRefreshRateOverride(RowIndex);
 
-	return SNew(SImage)
-		.Image(IconBrush)
-		.ColorAndOpacity(BaseColor)
-		.ToolTipText(PropertyInstanceInfo.GetType());
-}
+		State->PendingRows[RowIndex] = (
+			State->Rows.ParentIndices[RowIndex] != INDEX_NONE && 
+			!State->Rows.IsGroupRow[RowIndex] &&
+			(RefreshRateOverride == nullptr || *RefreshRateOverride > 0.0f));
 
-TSharedRef<SWidget> FLiveBlueprintDebuggerDetailCustomization::GenerateNameWidget(
-	const FFastPropertyInstanceInfo& PropertyInstanceInfo)
-{
-	return SNew(STextBlock)
-		.Text(PropertyInstanceInfo.GetDisplayName())
-		.ToolTipText(PropertyInstanceInfo.GetDisplayName());
-}
+		if (!State->PendingRows[RowIndex])
+		{
+			continue;
+		}
 
-TSharedRef<SWidget> FLiveBlueprintDebuggerDetailCustomization::GenerateValueWidget(
-	const FFastPropertyInstanceInfo& PropertyInstanceInfo)
-{
-	FText ValueText;
+		for (int32 InstanceIndex = 0; InstanceIndex < State->Rows.NumInstances(); InstanceIndex++)
+		{
+			if (ResolvedActors[InstanceIndex] != nullptr)
+			{
+				State->Rows.ValueHashes[State->Rows.GetCellIndex(RowIndex, InstanceIndex)] = ReadValueHash(RowIndex, InstanceIndex);
+			}
+		}
+	}
 
-	if (PropertyInstanceInfo.GetProperty()->IsA<FObjectProperty>() || 
-		PropertyInstanceInfo.GetProperty()->IsA<FInterfaceProperty>())
+	float RefreshPeriod = 1.0f;
+
+	switch (Settings->PropertyRefreshRate)
 	{
-		FString ValueAsString;
-		if (PropertyInstanceInfo.IsValid() && (PropertyInstanceInfo.GetObject().Get() != nullptr))
+		default:
+		case EPropertyRefreshRate::One:
 		{
-			ValueAsString = FString::Printf(
-				TEXT("%s (Class: %s)"),
-				*PropertyInstanceInfo.GetObject()->GetName(),
-				*PropertyInstanceInfo.GetObject()->GetClass()->GetName());
+			RefreshPeriod = 1.0f;
+			break;
 		}
-		else
+
+		case EPropertyRefreshRate::Ten:
 		{
-			ValueAsString = "None";
+			RefreshPeriod = 0.1f;
+			break;
 		}
 
-		ValueText = FText::FromString(ValueAsString);
-	}
-	else
-	{
-		const FString ValueAsString = PropertyInstanceInfo.GetValue().ToString();
-		ValueText = FText::FromString(ValueAsString.Replace(TEXT("\n"), TEXT(" ")));
+		case EPropertyRefreshRate::Thirty:
+		{
+			RefreshPeriod = 0.0334f;
+			break;
+		}
 	}
 
-	return SNew(STextBlock)
-		.Text(ValueText)
-		.ToolTipText(ValueText);
-}
-
-void FLiveBlueprintDebuggerDetailCustomization::UpdateWidgetRowValue(FLiveBlueprintWidgetRowData& WidgetRowData)
-{
-	// We have special handling for set, array, and map properties such that their immediate children 
-	// are also included in the ValueWidgetContainer. This allows the number of elements to change 
-	// dynamically without needing to add a new row to the Blueprint details category, which is not 
-	// feasible after it has been constructed.
+	const int32 NumRows = State->Rows.Num();
+	TArray<bool> IsRowSchedulable;
+	TArray<double> RowRefreshPeriods;
+	TArray<bool> IsRowAdaptive;
+	IsRowSchedulable.Reserve(NumRows);
+	RowRefreshPeriods.Reserve(NumRows);
+	IsRowAdaptive.Reserve(NumRows);
 
-	if (WidgetRowData.PropertyInstanceInfo.GetProperty()->IsA<FSetProperty>() ||
-		WidgetRowData.PropertyInstanceInfo.GetProperty()->IsA<FArrayProperty>() ||
-		WidgetRowData.PropertyInstanceInfo.GetProperty()->IsA<FMapProperty>())
+	for (int32 RowIndex = 0; RowIndex < NumRows; RowIndex++)
 	{
-		auto VerticalBox = SNew(SVerticalBox);
-		
-		for (auto& ChildPropertyInfo : WidgetRowData.PropertyInstanceInfo.GetChildren())
-		{
-			if (WidgetRowData.PropertyInstanceInfo.GetProperty()->IsA<FMapProperty>())
-			{
-				VerticalBox->AddSlot()
-					.AutoHeight()
-					[
-						SNew(SHorizontalBox)
-
-						+ SHorizontalBox::Slot()
-						.AutoWidth()
-						[
-							GenerateNameWidget(ChildPropertyInfo)
-						]
-
-						+ SHorizontalBox::Slot()
-						.AutoWidth()
-						.HAlign(HAlign_Left)
-						.Padding(.5f, 1.f)
-						[
-							GenerateValueWidget(ChildPropertyInfo)
-						]
-					];
-			}
-			else
-			{
-				VerticalBox->AddSlot()
-					.AutoHeight()
-					[
-						GenerateValueWidget(ChildPropertyInfo)
-					];
-			}
-		}
+		// Group rows summarize their children, so they are refreshed whenever a child changes
+		// rather than being polled themselves.
+		bool bIsRowSchedulable = !State->Rows.IsGroupRow[RowIndex];
+		double RowRefreshPeriod = RefreshPeriod;
+		bool bIsRowAdaptive = Settings->bAdaptiveRefreshRate;
+
+		// Variables with an overridden refresh rate are always polled at exactly that rate. 
+		// Members of a struct variable use the override of the variable they belong to.
+		const float* RefreshRateOverride = FindRefreshRateOverride(RowIndex);
 
-		if (WidgetRowData.PropertyInstanceInfo.GetChildren().Num() == 0)
+		if (RefreshRateOverride != nullptr)
 		{
-			VerticalBox->AddSlot()
-				.AutoHeight()
-				[
-					SNew(STextBlock)
-					.Text(FText::FromString("[empty]"))
-				];
+			bIsRowSchedulable &= (*RefreshRateOverride > 0.0f);
+			RowRefreshPeriod = (*RefreshRateOverride > 0.0f) ? 1.0 / *RefreshRateOverride : 0.0;
+			bIsRowAdaptive = false;
 		}
 
-#if ENGINE_MAJOR_VERSION == 4
-		WidgetRowData.ValueBorderWidget->SetContent
-			(
-				SAssignNew(WidgetRowData.ValueWidgetContainer, SHorizontalBox)
-
-				+ SHorizontalBox::Slot()
-				.AutoWidth()
-				.HAlign(HAlign_Left)
-				.Padding(.5f, 1.f)
-				[
-					VerticalBox
-				]
-			);
-#else
-		WidgetRowData.ValueWidgetContainer->GetSlot(0)
-			[
-				VerticalBox
-			];
-#endif
+		IsRowSchedulable.Add(bIsRowSchedulable);
+		RowRefreshPeriods.Add(RowRefreshPeriod);
+		IsRowAdaptive.Add(bIsRowAdaptive);
 	}
-	else
-	{
-#if ENGINE_MAJOR_VERSION == 4
-		WidgetRowData.ValueBorderWidget->SetContent
-			(
-				SAssignNew(WidgetRowData.ValueWidgetContainer, SHorizontalBox)
 
-				+ SHorizontalBox::Slot()
-				.AutoWidth()
-				.HAlign(HAlign_Left)
-				.Padding(.5f, 1.f)
-				[
-					GenerateValueWidget(WidgetRowData.PropertyInstanceInfo)
-				]
-			);
-#else
-		WidgetRowData.ValueWidgetContainer->GetSlot(0)
-			[
-				GenerateValueWidget(WidgetRowData.PropertyInstanceInfo)
-			];
-#endif
+	State->Scheduler.Initialize(
+		IsRowSchedulable, 
+		RowRefreshPeriods, 
+		IsRowAdaptive,
+		Settings->UpdateBudgetMicroseconds / 1'000'000.0);
+
+	State->ChangedGroupCells.Init(false, State->Rows.ValueWidgets.Num());
+
+	if (Settings->bSnapshotDiffing)
+	{
+		State->SnapshotDiffer.Initialize(State->Rows, ResolvedActors);
 	}
 }
 
-void FLiveBlueprintDebuggerDetailCustomization::UpdateWidgetRow(
-	FLiveBlueprintWidgetRowData& WidgetRowData,
-	double RealTimeInSeconds)
+bool FLiveBlueprintDebuggerDetailCustomization::ResolveActors()
 {
-	if (*WidgetRowData.PropertyInstanceInfo.GetProperty() == nullptr)
+	bool bAnyActorIsValid = false;
+
+	ResolvedActors.SetNum(Actors.Num());
+
+	for (int32 InstanceIndex = 0; InstanceIndex < Actors.Num(); InstanceIndex++)
 	{
-		return;
+		ResolvedActors[InstanceIndex] = Actors[InstanceIndex].Get();
+		bAnyActorIsValid |= (ResolvedActors[InstanceIndex] != nullptr);
 	}
 
-	SBorder& Border = *WidgetRowData.ValueBorderWidget;
+	return bAnyActorIsValid;
+}
 
-	uint32 NewValueHash = WidgetRowData.PropertyInstanceInfo.GetValueHash();
+const float* FLiveBlueprintDebuggerDetailCustomization::FindRefreshRateOverride(int32 RowIndex) const
+{
+	const TMap<FName, float>& RefreshRateOverrides = GetDefault<ULiveBlueprintDebuggerSettings>()->VariableRefreshRateOverrides;
 
-	if (NewValueHash != WidgetRowData.ValueHash)
+	if (RefreshRateOverrides.Num() == 0)
 	{
-		WidgetRowData.PropertyInstanceInfo.Refresh();
-		UpdateWidgetRowValue(WidgetRowData);
-
-		WidgetRowData.ValueHash = WidgetRowData.PropertyInstanceInfo.GetValueHash();
-		WidgetRowData.LastUpdateTimeInSeconds = RealTimeInSeconds;
+		return nullptr;
 	}
 
-	const ULiveBlueprintDebuggerSettings* Settings = GetDefault<ULiveBlueprintDebuggerSettings>();
+	// Overrides are keyed by the name of the Blueprint variable, so look up the top-level row.
+	int32 VariableRowIndex = RowIndex;
 
-	if (Settings->bHighlightValuesThatHaveChanged)
+	while (State->Rows.ParentIndices[VariableRowIndex] != INDEX_NONE)
 	{
-		double TimeSincePropertyChanged = (RealTimeInSeconds - WidgetRowData.LastUpdateTimeInSeconds);
-		if (TimeSincePropertyChanged <= 2.0)
-		{
-			FLinearColor BackgroundColor = Settings->PropertyChangedHighlightColor;
-			BackgroundColor.A = BackgroundColor.A * (1.0f - static_cast<float>(std::clamp(TimeSincePropertyChanged, 0.0, 1.0)));
-			Border.SetBorderBackgroundColor(BackgroundColor);
+		VariableRowIndex = State->Rows.ParentIndices[VariableRowIndex];
+	}
+
+	return RefreshRateOverrides.Find(State->Rows.Properties[VariableRowIndex]->GetFName());
+}
+
+bool FLiveBlueprintDebuggerDetailCustomization::IsShownIn(const IDetailsView* InDetailsView) const
+{
+	return DetailsViewKey == InDetailsView;
+}
+
+bool FLiveBlueprintDebuggerDetailCustomization::IsDetailsViewOpen() const
+{
+	return DetailsViewKey == nullptr || DetailsView.IsValid();
+}
+
+uint32 FLiveBlueprintDebuggerDetailCustomization::ReadValueHash(int32 RowIndex, int32 InstanceIndex)
+{
+	// The first panel to poll the row this frame hashes it, and the others reuse that hash. Each
+	// panel still compares it against the hash it last showed, so every panel sees the change.
+	FLiveBlueprintSharedReads& Reads = *State->SharedReads[InstanceIndex];
+
+	if (Reads.ReadFrames[RowIndex] != GFrameCounter)
+	{
+		Reads.ValueHashes[RowIndex] = State->Rows.HashValue(RowIndex, ResolvedActors[InstanceIndex]);
+		Reads.ReadFrames[RowIndex] = GFrameCounter;
+	}
+
+	return Reads.ValueHashes[RowIndex];
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::UpdateBlueprintDetails()
+{
+	LIVE_BLUEPRINT_SCOPE(Update);
+
+	// The property pointers of a stale layout may no longer be valid. The details panel will be
+	// rebuilt with a fresh layout once the class has finished recompiling.
+	if (!World.IsValid() || !IsDetailsViewOpen() || ClassLayout->IsStale() || !ResolveActors())
+	{
+		ValueFormatter.Cancel();
+		return;
+	}
+
+	const double UpdateStartTime = FPlatformTime::Seconds();
+	const double RealTimeInSeconds = World->GetRealTimeSeconds();
+	const double SlateTimeInSeconds = bHasWidgets ? FSlateApplication::Get().GetCurrentTime() : 0.0;
+
+	State->ValueHistory->SetCurrentTime(RealTimeInSeconds);
+
+	// Values that changed during a previous update are shown once they have been formatted.
+	ValueFormatter.ApplyResults(
+		[this](int32 CellIndex, const FText& ValueText)
+		{
+			SetWidgetCellValue(CellIndex, ValueText);
+		});
+
+	// While recording, every row is polled so that the recording has the full history of every
+	// variable, not just of the ones that happened to be scrolled into view.
+	const bool bIsRecording = SyncWithRecorder();
+
+	// Rows covered by the snapshot are still polled on their own schedule, but they only need to be
+	// hashed if their memory changed since they were last polled.
+	State->SnapshotDiffer.Diff(ResolvedActors);
+
+	int32 NumRowsPolled = 0;
+	int32 NumRowsUpdated = 0;
+	int32 NumRowsSkipped = 0;
+
+	{
+		LIVE_BLUEPRINT_SCOPE(PollRows);
+
+		State->Scheduler.Tick(
+			RealTimeInSeconds,
+			[this, bIsRecording, SlateTimeInSeconds, &NumRowsSkipped](int32 RowIndex)
+			{
+				const bool bIsVisible = bIsRecording || IsRowVisible(RowIndex, SlateTimeInSeconds);
+				NumRowsSkipped += bIsVisible ? 0 : 1;
+				return bIsVisible;
+			},
+			[this, bIsRecording, RealTimeInSeconds, SlateTimeInSeconds, &NumRowsPolled, &NumRowsUpdated](int32 RowIndex)
+			{
+				const bool bIsShown = bIsRecording || IsRowShown(RowIndex, SlateTimeInSeconds);
+				const bool bRowChanged = UpdateWidgetRow(RowIndex, bIsShown, RealTimeInSeconds);
+				NumRowsPolled++;
+				NumRowsUpdated += bRowChanged ? 1 : 0;
+				return bRowChanged;
+			});
+	}
+
+	LastUpdateCounts = { NumRowsPolled, NumRowsUpdated, NumRowsSkipped };
+
+	INC_DWORD_STAT_BY(STAT_LiveBlueprint_RowsPolled, NumRowsPolled);
+	INC_DWORD_STAT_BY(STAT_LiveBlueprint_RowsUpdated, NumRowsUpdated);
+	INC_DWORD_STAT_BY(STAT_LiveBlueprint_RowsSkipped, NumRowsSkipped);
+	TRACE_COUNTER_ADD(LiveBlueprint_RowsPolled, NumRowsPolled);
+	TRACE_COUNTER_ADD(LiveBlueprint_RowsUpdated, NumRowsUpdated);
+	TRACE_COUNTER_ADD(LiveBlueprint_RowsSkipped, NumRowsSkipped);
+
+	// Group rows show a summary of their children, so they only need to be refreshed when one of
+	// their children changed. This avoids re-hashing the whole struct at every level of nesting.
+	{
+		LIVE_BLUEPRINT_SCOPE(UpdateGroupRows);
+
+		for (TConstSetBitIterator<> It(State->ChangedGroupCells); It; ++It)
+		{
+			const int32 CellIndex = It.GetIndex();
+			const int32 RowIndex = CellIndex / State->Rows.NumInstances();
+			const int32 InstanceIndex = CellIndex % State->Rows.NumInstances();
+
+			QueueWidgetCellValue(RowIndex, InstanceIndex);
+			State->Rows.LastUpdateTimes[CellIndex] = RealTimeInSeconds;
+			State->Scheduler.MarkRowChanged(RowIndex, RealTimeInSeconds);
+		}
+
+		State->ChangedGroupCells.Init(false, State->Rows.ValueWidgets.Num());
+	}
+
+	ValueFormatter.Dispatch();
+
+	UpdateHighlights(RealTimeInSeconds);
+	UpdateMemoryStats();
+
+	if (OverheadTextBlock.IsValid())
+	{
+		AddOverheadSample(FPlatformTime::Seconds() - UpdateStartTime, NumRowsUpdated, NumRowsSkipped, RealTimeInSeconds);
+	}
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::UpdateMemoryStats()
+{
+	// The element hashes of container rows grow and shrink with the page being shown, so the memory
+	// held by the rows is re-measured after every update and only the difference is reported.
+	const SIZE_T MemorySize = State->GetAllocatedSize();
+
+	if (MemorySize == State->ReportedMemorySize)
+	{
+		return;
+	}
+
+	DEC_MEMORY_STAT_BY(STAT_LiveBlueprint_RowMemory, State->ReportedMemorySize);
+	INC_MEMORY_STAT_BY(STAT_LiveBlueprint_RowMemory, MemorySize);
+	TRACE_COUNTER_SUBTRACT(LiveBlueprint_RowMemory, State->ReportedMemorySize);
+	TRACE_COUNTER_ADD(LiveBlueprint_RowMemory, MemorySize);
+	State->ReportedMemorySize = MemorySize;
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::AddOverheadSample(
+	double DurationInSeconds, 
+	int32 NumRowsUpdated, 
+	int32 NumRowsSkipped, 
+	double RealTimeInSeconds)
+{
+	// The sums are kept up-to-date as samples are replaced, so the averages don't need to loop over
+	// all of the samples.
+	FOverheadSample& Sample = OverheadSamples[NextOverheadSample];
+	OverheadSampleSums.DurationInSeconds += DurationInSeconds - Sample.DurationInSeconds;
+	OverheadSampleSums.NumRowsUpdated += NumRowsUpdated - Sample.NumRowsUpdated;
+	OverheadSampleSums.NumRowsSkipped += NumRowsSkipped - Sample.NumRowsSkipped;
+	Sample = { DurationInSeconds, NumRowsUpdated, NumRowsSkipped };
+
+	NextOverheadSample = (NextOverheadSample + 1) % NumOverheadSamples;
+	NumOverheadSamplesAdded = FMath::Min(NumOverheadSamplesAdded + 1, NumOverheadSamples);
+
+	if (RealTimeInSeconds - LastOverheadTextTime >= OverheadTextRefreshPeriod)
+	{
+		LastOverheadTextTime = RealTimeInSeconds;
+		OverheadTextBlock->SetText(GetOverheadText());
+	}
+}
+
+FText FLiveBlueprintDebuggerDetailCustomization::GetOverheadText() const
+{
+	const FOverheadSample& LastSample = OverheadSamples[(NextOverheadSample + NumOverheadSamples - 1) % NumOverheadSamples];
+	const double NumSamples = FMath::Max(NumOverheadSamplesAdded, 1);
+
+	FNumberFormattingOptions MillisecondsFormat;
+	MillisecondsFormat.SetMinimumFractionalDigits(2).SetMaximumFractionalDigits(2);
+
+	FNumberFormattingOptions RowsFormat;
+	RowsFormat.SetMaximumFractionalDigits(1);
+
+	// The class layout is shared between every selection of the class, but it is built for the
+	// debugger alone, so it is counted in full.
+	return FText::Format(
+		LOCTEXT("OverheadText", "{0} ms last update, {1} ms average\n{2} rows updated, {3} skipped per update\n{4} of memory"),
+		FText::AsNumber(LastSample.DurationInSeconds * 1000.0, &MillisecondsFormat),
+		FText::AsNumber(OverheadSampleSums.DurationInSeconds * 1000.0 / NumSamples, &MillisecondsFormat),
+		FText::AsNumber(OverheadSampleSums.NumRowsUpdated / NumSamples, &RowsFormat),
+		FText::AsNumber(OverheadSampleSums.NumRowsSkipped / NumSamples, &RowsFormat),
+		FText::AsMemory(State->ReportedMemorySize + ClassLayout->GetAllocatedSize()));
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::WaitForFormatting()
+{
+	ValueFormatter.Wait();
+}
+
+const FLiveBlueprintDebuggerDetailCustomization::FUpdateCounts& FLiveBlueprintDebuggerDetailCustomization::GetLastUpdateCounts() const
+{
+	return LastUpdateCounts;
+}
+
+SIZE_T FLiveBlueprintDebuggerDetailCustomization::GetAllocatedSize() const
+{
+	return State->GetAllocatedSize() + ClassLayout->GetAllocatedSize();
+}
+
+bool FLiveBlueprintDebuggerDetailCustomization::IsRowVisible(int32 RowIndex, double SlateTimeInSeconds) const
+{
+	// A row inside a collapsed group is still needed to keep the summary in the group's header row 
+	// up-to-date, so a row counts as visible if it or any of its parent groups is visible.
+	// All of the instances of a row are shown in the same details row, so checking the first one is
+	// enough.
+	if (!bHasWidgets)
+	{
+		return RowIndex < NumRowsShownWithoutWidgets;
+	}
+
+	for (int32 AncestorIndex = RowIndex; AncestorIndex != INDEX_NONE; AncestorIndex = State->Rows.ParentIndices[AncestorIndex])
+	{
+		const TSharedPtr<SLiveBlueprintValueWidget>& ValueWidget = State->Rows.ValueWidgets[State->Rows.GetCellIndex(AncestorIndex, 0)];
+
+		if (ValueWidget.IsValid() && ValueWidget->WasPaintedRecently(SlateTimeInSeconds))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FLiveBlueprintDebuggerDetailCustomization::IsRowShown(int32 RowIndex, double SlateTimeInSeconds) const
+{
+	// Unlike IsRowVisible, only the row's own value widget counts, not the headers of its groups.
+	if (!bHasWidgets)
+	{
+		return RowIndex < NumRowsShownWithoutWidgets;
+	}
+
+	const TSharedPtr<SLiveBlueprintValueWidget>& ValueWidget = State->Rows.ValueWidgets[State->Rows.GetCellIndex(RowIndex, 0)];
+	return ValueWidget.IsValid() && ValueWidget->WasPaintedRecently(SlateTimeInSeconds);
+}
+
+bool FLiveBlueprintDebuggerDetailCustomization::SyncWithRecorder()
+{
+	FLiveBlueprintRecorder& Recorder = FLiveBlueprintRecorder::Get();
+
+	if (!Recorder.IsRecording())
+	{
+		State->RecordingSessionId = 0;
+		return false;
+	}
+
+	State->RecordingTimeInSeconds = Recorder.GetTimeInSeconds();
+
+	if (State->RecordingSessionId == Recorder.GetSessionId())
+	{
+		return true;
+	}
+
+	// A new recording was started, or this selection has not been recorded yet. Register the 
+	// class and the actors, then record the current value of every row so that the recording
+	// doesn't depend on what was recorded before the actors were selected.
+	State->RecordingSessionId = Recorder.GetSessionId();
+	const uint32 SchemaId = Recorder.RegisterSchema(*ClassLayout);
+
+	State->RecordingInstanceIds.Init(0, State->Rows.NumInstances());
+	State->RecordedContainerHashes.Init(0, State->Rows.ValueWidgets.Num());
+
+	for (int32 InstanceIndex = 0; InstanceIndex < State->Rows.NumInstances(); InstanceIndex++)
+	{
+		if (ResolvedActors[InstanceIndex] != nullptr)
+		{
+			State->RecordingInstanceIds[InstanceIndex] = Recorder.RegisterInstance(ResolvedActors[InstanceIndex], SchemaId);
+		}
+	}
+
+	for (int32 RowIndex = 0; RowIndex < State->Rows.Num(); RowIndex++)
+	{
+		for (int32 InstanceIndex = 0; InstanceIndex < State->Rows.NumInstances(); InstanceIndex++)
+		{
+			RecordCellValue(RowIndex, InstanceIndex, true);
+		}
+	}
+
+	return true;
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::RecordCellValue(int32 RowIndex, int32 InstanceIndex, bool bForce)
+{
+	// Group rows are recorded through their members. Actors whose definition could not be recorded
+	// have no instance id.
+	if (State->RecordingSessionId == 0 || 
+		State->Rows.IsGroupRow[RowIndex] || 
+		ResolvedActors[InstanceIndex] == nullptr || 
+		State->RecordingInstanceIds[InstanceIndex] == 0)
+	{
+		return;
+	}
+
+	if (State->Rows.IsContainerRow(RowIndex))
+	{
+		const uint32 ValueHash = State->Rows.HashValue(RowIndex, ResolvedActors[InstanceIndex]);
+		uint32& RecordedHash = State->RecordedContainerHashes[State->Rows.GetCellIndex(RowIndex, InstanceIndex)];
+
+		if (ValueHash == RecordedHash && !bForce)
+		{
+			return;
+		}
+
+		RecordedHash = ValueHash;
+	}
+
+	FLiveBlueprintRecorder::Get().RecordValue(
+		State->RecordingTimeInSeconds,
+		State->RecordingInstanceIds[InstanceIndex],
+		RowIndex,
+		State->Rows.ValueKinds[RowIndex],
+		State->Rows.Properties[RowIndex],
+		State->Rows.GetValuePointer(RowIndex, ResolvedActors[InstanceIndex]));
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::ExpandPropertyChildren(
+	IDetailGroup& Group,
+	int32 GroupRowIndex)
+{
+	const TArray<FLiveBlueprintPropertyLayout>& PropertyLayouts = ClassLayout->GetProperties();
+	const int32 GroupDepth = PropertyLayouts[GroupRowIndex].Depth;
+
+	// Fill in the group's header row.
+	FillInWidgetRow(Group.HeaderRow(), GroupRowIndex);
+
+	// All of the group's descendants directly follow its header row in the layout.
+	for (int32 RowIndex = GroupRowIndex + 1; 
+		RowIndex < PropertyLayouts.Num() && PropertyLayouts[RowIndex].Depth > GroupDepth; 
+		RowIndex++)
+	{
+		const FLiveBlueprintPropertyLayout& PropertyLayout = PropertyLayouts[RowIndex];
+
+		if (PropertyLayout.ParentIndex != GroupRowIndex)
+		{
+			continue;
+		}
+
+		if (PropertyLayout.bIsGroup)
+		{
+			IDetailGroup& SubGroup = Group.AddGroup(
+				PropertyLayout.Property->GetFName(),
+				PropertyLayout.DisplayName,
+				false);
+
+			ExpandPropertyChildren(SubGroup, RowIndex);
+		}
+		else
+		{
+			FillInWidgetRow(Group.AddWidgetRow(), RowIndex);
+		}
+	}
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::FillInWidgetRow(
+	FDetailWidgetRow& WidgetRow,
+	int32 RowIndex)
+{
+	LIVE_BLUEPRINT_SCOPE(BuildWidgetRows);
+
+	const FLiveBlueprintPropertyLayout& PropertyLayout = ClassLayout->GetProperties()[RowIndex];
+
+	FString Indentation = std::wstring(PropertyLayout.Depth * 2, L' ').c_str();
+
+    UE_LOG(
+        LogLiveBlueprintDebugger,
+		Verbose,
+        TEXT("%sProperty: '%s' [%s] \tFlags: 0x%08X"),
+		*Indentation,
+        *PropertyLayout.Property->GetName(),
+        *PropertyLayout.Property->GetClass()->GetName(),
+		PropertyLayout.Property->GetPropertyFlags());
+
+	WidgetRow
+		.NameContent()
+		[
+			SNew(SHorizontalBox)
+			
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.HAlign(HAlign_Left)
+			.VAlign(VAlign_Center)
+			[
+				GenerateNameIcon(PropertyLayout)
+			]
+			
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.HAlign(HAlign_Left)
+			.VAlign(VAlign_Center)
+			.Padding(5.f, 0.f, 0.f, 0.f)
+			[
+				GenerateNameWidget(PropertyLayout.DisplayName)
+			]
+		]
+		.ValueContent()
+		[
+			GenerateValueWidgets(RowIndex)
+		];
+
+	if (State->PendingRows[RowIndex])
+	{
+		return;
+	}
+
+	for (int32 InstanceIndex = 0; InstanceIndex < State->Rows.NumInstances(); InstanceIndex++)
+	{
+		if (bRebindWidgets)
+		{
+			RebindWidgetCell(RowIndex, InstanceIndex);
+		}
+		else
+		{
+			FillInWidgetCell(RowIndex, InstanceIndex, State->ValueHistory->GetCurrentTime());
+		}
+	}
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::FillInWidgetCell(
+	int32 RowIndex, 
+	int32 InstanceIndex, 
+	double RealTimeInSeconds)
+{
+	if (ResolvedActors[InstanceIndex] == nullptr)
+	{
+		return;
+	}
+
+	if (State->Rows.IsContainerRow(RowIndex))
+	{
+		UpdateContainerElements(RowIndex, InstanceIndex, 0.0);
+	}
+	else
+	{
+		if (!State->Rows.IsGroupRow[RowIndex])
+		{
+			State->Rows.ValueHashes[State->Rows.GetCellIndex(RowIndex, InstanceIndex)] = ReadValueHash(RowIndex, InstanceIndex);
+		}
+
+		UpdateWidgetCellValue(RowIndex, InstanceIndex);
+		RecordHistorySample(RowIndex, InstanceIndex, RealTimeInSeconds);
+	}
+
+	RecordCellValue(RowIndex, InstanceIndex, false);
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::RebindWidgetCell(int32 RowIndex, int32 InstanceIndex)
+{
+	if (ResolvedActors[InstanceIndex] == nullptr)
+	{
+		return;
+	}
+
+	// Rows that are never polled can't have caught up with changes made while the state was cached.
+	const float* RefreshRateOverride = FindRefreshRateOverride(RowIndex);
+
+	if (RefreshRateOverride != nullptr && *RefreshRateOverride <= 0.0f)
+	{
+		FillInWidgetCell(RowIndex, InstanceIndex, State->ValueHistory->GetCurrentTime());
+		return;
+	}
+
+	const int32 CellIndex = State->Rows.GetCellIndex(RowIndex, InstanceIndex);
+
+	// The new widget of a container starts out empty on its first page, so the elements are
+	// formatted again. Only one page of them is ever shown, so this is cheap.
+	if (State->Rows.IsContainerRow(RowIndex))
+	{
+		State->Rows.ContainerStates[State->Rows.ContainerStateIndices[CellIndex]] = FLiveBlueprintContainerState();
+		UpdateContainerElements(RowIndex, InstanceIndex, 0.0);
+	}
+	else
+	{
+		// This is the text from when the state was cached. The row is due on the first update, which
+		// replaces it if the value changed since.
+		State->Rows.ValueWidgets[CellIndex]->SetValueText(State->ValueTexts[CellIndex]);
+	}
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::RecordHistorySample(
+	int32 RowIndex, 
+	int32 InstanceIndex, 
+	double RealTimeInSeconds)
+{
+	const int32 HistorySlotIndex = State->Rows.HistorySlotIndices[State->Rows.GetCellIndex(RowIndex, InstanceIndex)];
+
+	if (HistorySlotIndex != INDEX_NONE)
+	{
+		State->ValueHistory->AddSample(
+			HistorySlotIndex,
+			RealTimeInSeconds,
+			State->Rows.Accessors[RowIndex].ReadNumber(
+				State->Rows.Properties[RowIndex], 
+				State->Rows.GetValuePointer(RowIndex, ResolvedActors[InstanceIndex])));
+	}
+}
+
+TSharedRef<SWidget> FLiveBlueprintDebuggerDetailCustomization::GenerateValueWidgets(int32 RowIndex)
+{
+	const int32 ElementsPerPage = GetDefault<ULiveBlueprintDebuggerSettings>()->ContainerElementsPerPage;
+
+	auto CreateValueWidget = [&](int32 InstanceIndex) -> TSharedRef<SWidget>
+	{
+		const int32 CellIndex = State->Rows.GetCellIndex(RowIndex, InstanceIndex);
+
+		TSharedRef<SWidget> ValueWidget = SAssignNew(State->Rows.ValueWidgets[CellIndex], SLiveBlueprintValueWidget)
+			.IsContainer(State->Rows.IsContainerRow(RowIndex))
+			.IsReference(
+				State->Rows.ValueKinds[RowIndex] == EPropertyValueKind::Object ||
+				State->Rows.ValueKinds[RowIndex] == EPropertyValueKind::Interface)
+			.ShowElementNames(State->Rows.ValueKinds[RowIndex] == EPropertyValueKind::Map)
+			.ElementsPerPage(ElementsPerPage)
+			.OnExpanderClicked(FOnLiveBlueprintExpanderClicked::CreateRaw(
+				this,
+				&FLiveBlueprintDebuggerDetailCustomization::OnReferenceExpanderClicked,
+				CellIndex))
+			.OnPageChanged(FOnLiveBlueprintPageChanged::CreateRaw(
+				this,
+				&FLiveBlueprintDebuggerDetailCustomization::OnContainerPageChanged,
+				CellIndex));
+
+		if (State->Rows.HistorySlotIndices[CellIndex] == INDEX_NONE)
+		{
+			return ValueWidget;
+		}
+
+		return SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.f)
+			[
+				ValueWidget
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(5.f, 0.f, 0.f, 0.f)
+			[
+				SNew(SLiveBlueprintSparkline)
+				.History(State->ValueHistory)
+				.SlotIndex(State->Rows.HistorySlotIndices[CellIndex])
+			];
+	};
+
+	if (State->Rows.NumInstances() == 1)
+	{
+		return CreateValueWidget(0);
+	}
+
+	// When several actors are selected, their values are stacked in the value column, each one 
+	// labeled with the actor it belongs to, so they can be compared at a glance.
+	TSharedRef<SVerticalBox> InstancesBox = SNew(SVerticalBox);
+
+	for (int32 InstanceIndex = 0; InstanceIndex < State->Rows.NumInstances(); InstanceIndex++)
+	{
+		const FText ActorLabel = (ResolvedActors[InstanceIndex] != nullptr) ?
+			FText::FromString(ResolvedActors[InstanceIndex]->GetActorLabel()) :
+			FText::GetEmpty();
+
+		InstancesBox->AddSlot()
+			.AutoHeight()
+			[
+				SNew(SHorizontalBox)
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Top)
+				.Padding(0.f, 0.f, 5.f, 0.f)
+				[
+					SNew(STextBlock)
+					.Text(FText::Format(LOCTEXT("InstanceLabel", "{0}:"), ActorLabel))
+					.ToolTipText(ActorLabel)
+					.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+				]
+
+				+ SHorizontalBox::Slot()
+				.FillWidth(1.f)
+				[
+					CreateValueWidget(InstanceIndex)
+				]
+			];
+	}
+
+	return InstancesBox;
+}
+
+FFastPropertyInstanceInfo FLiveBlueprintDebuggerDetailCustomization::GetPropertyInstanceInfo(int32 RowIndex, int32 InstanceIndex) const
+{
+	return FFastPropertyInstanceInfo{
+		State->Rows.GetValuePointer(RowIndex, ResolvedActors[InstanceIndex]),
+		State->Rows.Properties[RowIndex],
+		FFastPropertyInstanceInfo::value_pointer_marker{} };
+}
+
+TSharedRef<SWidget> FLiveBlueprintDebuggerDetailCustomization::GenerateNameIcon(
+	const FLiveBlueprintPropertyLayout& PropertyLayout)
+{
+	// Unreal 5.1 has a bug where calling FDebugLineItem::GetNameIcon will crash if the given 
+	// property falls back to the default icon. So instead of relying on this, we create our 
+	// own icon in a similar way to the Kismet / Blueprint Debugger here.
+	
+	FSlateColor BaseColor;
+	FSlateColor UnusedColor;
+	FSlateBrush const* UnusedIcon = nullptr;
+	const FSlateBrush* IconBrush = FBlueprintEditor::GetVarIconAndColorFromProperty(
+		PropertyLayout.Property,
+		BaseColor,
+		UnusedIcon,
+		UnusedColor
+	);
+
+	return SNew(SImage)
+		.Image(IconBrush)
+		.ColorAndOpacity(BaseColor)
+		.ToolTipText(PropertyLayout.TypeText);
+}
+
+TSharedRef<SWidget> FLiveBlueprintDebuggerDetailCustomization::GenerateNameWidget(
+	const FText& DisplayName)
+{
+	return SNew(STextBlock)
+		.Text(DisplayName)
+		.ToolTipText(DisplayName);
+}
+
+FText FLiveBlueprintDebuggerDetailCustomization::GetValueText(
+	const FFastPropertyInstanceInfo& PropertyInstanceInfo)
+{
+	FText ValueText;
+
+	if (PropertyInstanceInfo.GetProperty()->IsA<FObjectProperty>() || 
+		PropertyInstanceInfo.GetProperty()->IsA<FInterfaceProperty>())
+	{
+		FString ValueAsString;
+		if (PropertyInstanceInfo.IsValid() && (PropertyInstanceInfo.GetObject().Get() != nullptr))
+		{
+			ValueAsString = FString::Printf(
+				TEXT("%s (Class: %s)"),
+				*PropertyInstanceInfo.GetObject()->GetName(),
+				*PropertyInstanceInfo.GetObject()->GetClass()->GetName());
+		}
+		else
+		{
+			ValueAsString = "None";
+		}
+
+		ValueText = FText::FromString(ValueAsString);
+	}
+	else
+	{
+		const FString ValueAsString = PropertyInstanceInfo.GetValue().ToString();
+		ValueText = FText::FromString(ValueAsString.Replace(TEXT("\n"), TEXT(" ")));
+	}
+
+	return ValueText;
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::UpdateWidgetCellValue(int32 RowIndex, int32 InstanceIndex)
+{
+	LIVE_BLUEPRINT_SCOPE(FormatValue);
+
+	const int32 CellIndex = State->Rows.GetCellIndex(RowIndex, InstanceIndex);
+
+	// Rows that can be formatted on a worker thread are always formatted by the formatter, so their
+	// text doesn't depend on which thread formatted it.
+	if (ValueFormatter.CanFormat(RowIndex))
+	{
+		SetWidgetCellValue(
+			CellIndex, 
+			ValueFormatter.FormatOnGameThread(
+				RowIndex, 
+				State->Rows.GetValuePointer(RowIndex, ResolvedActors[InstanceIndex])));
+	}
+	else
+	{
+		SetWidgetCellValue(CellIndex, GetValueText(GetPropertyInstanceInfo(RowIndex, InstanceIndex)));
+	}
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::SetWidgetCellValue(int32 CellIndex, const FText& ValueText)
+{
+	State->ValueTexts[CellIndex] = ValueText;
+
+	if (bHasWidgets)
+	{
+		State->Rows.ValueWidgets[CellIndex]->SetValueText(ValueText);
+	}
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::QueueWidgetCellValue(int32 RowIndex, int32 InstanceIndex)
+{
+	// Numbers, enums, and bools are copied and formatted on a worker thread. Everything else can
+	// refer to memory that the game may change at any time, or needs the game thread to be
+	// formatted, so it is formatted right away.
+	if (!ValueFormatter.CanFormat(RowIndex) || 
+		!ValueFormatter.Snapshot(
+			RowIndex, 
+			InstanceIndex, 
+			State->Rows.GetValuePointer(RowIndex, ResolvedActors[InstanceIndex])))
+	{
+		UpdateWidgetCellValue(RowIndex, InstanceIndex);
+	}
+}
+
+bool FLiveBlueprintDebuggerDetailCustomization::UpdateContainerElements(
+	int32 RowIndex, 
+	int32 InstanceIndex, 
+	double RealTimeInSeconds)
+{
+	LIVE_BLUEPRINT_SCOPE(UpdateContainerElements);
+
+	// We have special handling for set, array, and map properties such that their immediate children 
+	// are also included in the value widget. This allows the number of elements to change 
+	// dynamically without needing to add a new row to the Blueprint details category, which is not 
+	// feasible after it has been constructed.
+	//
+	// Each element is hashed individually so that only the elements that were added or changed 
+	// need to be formatted and highlighted. Only the page of elements that is currently shown is
+	// formatted at all, which keeps the cost bounded for very large containers. Arrays are diffed by
+	// position, so only their shown page is hashed. Sets and maps are diffed by key, which needs the
+	// keys of every element. They are still hashed as a whole on every poll, so their cost grows with
+	// the number of elements, but the table of keys is only rebuilt when that hash changed.
+
+	const int32 CellIndex = State->Rows.GetCellIndex(RowIndex, InstanceIndex);
+	FLiveBlueprintContainerState& ContainerState = State->Rows.ContainerStates[State->Rows.ContainerStateIndices[CellIndex]];
+	SLiveBlueprintValueWidget* ValueWidget = State->Rows.ValueWidgets[CellIndex].Get();
+	FContainerElementHelper Elements{ 
+		State->Rows.ValueKinds[RowIndex], 
+		State->Rows.Properties[RowIndex], 
+		State->Rows.GetValuePointer(RowIndex, ResolvedActors[InstanceIndex]) };
+
+	const int32 TotalNumElements = Elements.Num();
+	const bool bIsKeyed = (State->Rows.ValueKinds[RowIndex] != EPropertyValueKind::Array);
+	bool bContainerChanged = false;
+
+	if (TotalNumElements != ContainerState.TotalNumElements)
+	{
+		ContainerState.TotalNumElements = TotalNumElements;
+
+		if (ValueWidget != nullptr)
+		{
+			ValueWidget->SetTotalNumElements(TotalNumElements);
+		}
+
+		State->Rows.LastUpdateTimes[CellIndex] = RealTimeInSeconds;
+		bContainerChanged = true;
+	}
+
+	// A key that was added, removed, or given a new value changes the container even if it is not on
+	// the shown page, or if it replaced another key without changing the number of elements. The
+	// table of keys is only rebuilt when the hash of the whole container changed, and otherwise
+	// also describes the previous state. The two tables swap places on every rebuild, so their
+	// allocations are reused.
+	const uint32 KeyedValueHash = bIsKeyed ? ReadValueHash(RowIndex, InstanceIndex) : 0;
+	const bool bRebuildKeys = bIsKeyed && 
+		(!ContainerState.bHasKeyedElementHashes || KeyedValueHash != ContainerState.KeyedValueHash);
+	const TMap<uint32, uint32>& PreviousKeyedElementHashes = bRebuildKeys ? 
+		ContainerState.PreviousKeyedElementHashes : 
+		ContainerState.KeyedElementHashes;
+
+	if (bRebuildKeys)
+	{
+		Swap(ContainerState.KeyedElementHashes, ContainerState.PreviousKeyedElementHashes);
+		ContainerState.KeyedElementHashes.Reset();
+		ContainerState.KeyedElementHashes.Reserve(TotalNumElements);
+		ContainerState.KeyedValueHash = KeyedValueHash;
+		ContainerState.bHasKeyedElementHashes = true;
+		bool bKeysChanged = false;
+
+		Elements.ForEachElement(
+			[&](int32 ElementIndex, const FProperty* KeyProperty, void* KeyPointer, const FProperty* ElementProperty, void* ElementPointer)
+			{
+				const uint32 ElementHash = FPropertyValueHasher::HashValue(ElementProperty, ElementPointer);
+				const uint32 KeyHash = (KeyProperty != nullptr) ?
+					FPropertyValueHasher::HashValue(KeyProperty, KeyPointer) :
+					ElementHash;
+
+				const uint32* PreviousElementHash = PreviousKeyedElementHashes.Find(KeyHash);
+				bKeysChanged |= (PreviousElementHash == nullptr || *PreviousElementHash != ElementHash);
+				ContainerState.KeyedElementHashes.Add(KeyHash, ElementHash);
+			});
+
+		bKeysChanged |= (ContainerState.KeyedElementHashes.Num() != PreviousKeyedElementHashes.Num());
+
+		if (bKeysChanged)
+		{
+			State->Rows.LastUpdateTimes[CellIndex] = RealTimeInSeconds;
+			bContainerChanged = true;
+		}
+	}
+
+	// Every element needs to be reformatted when the user switches to a different page. Without a
+	// widget, the first page is shown.
+	const int32 FirstVisibleElement = (ValueWidget != nullptr) ? 
+		ValueWidget->GetFirstVisibleElement() : 
+		ContainerState.FirstVisibleElement;
+	const int32 ElementsPerPage = (ValueWidget != nullptr) ? 
+		ValueWidget->GetElementsPerPage() : 
+		GetDefault<ULiveBlueprintDebuggerSettings>()->ContainerElementsPerPage;
+
+	const bool bPageChanged = (FirstVisibleElement != ContainerState.FirstVisibleElement);
+
+	if (bPageChanged)
+	{
+		// The page only changes when the user pages through the widget.
+		for (int32 VisibleIndex = 0; VisibleIndex < ContainerState.ElementHashes.Num(); VisibleIndex++)
+		{
+			ValueWidget->SetElementHighlightColor(VisibleIndex, FLinearColor::Transparent);
+		}
+
+		ContainerState.FirstVisibleElement = FirstVisibleElement;
+		ContainerState.ElementHashes.Reset();
+		ContainerState.ElementUpdateTimes.Reset();
+		ContainerState.ElementKeyHashes.Reset();
+	}
+
+	const int32 PreviousNumVisibleElements = ContainerState.ElementHashes.Num();
+	const int32 NumVisibleElements = FMath::Clamp(
+		TotalNumElements - FirstVisibleElement, 
+		0, 
+		ElementsPerPage);
+
+	if (NumVisibleElements != PreviousNumVisibleElements)
+	{
+		ContainerState.ElementHashes.SetNum(NumVisibleElements);
+		ContainerState.ElementUpdateTimes.SetNum(NumVisibleElements);
+		ContainerState.ElementKeyHashes.SetNum(bIsKeyed ? NumVisibleElements : 0);
+
+		if (ValueWidget != nullptr)
+		{
+			ValueWidget->SetNumElements(NumVisibleElements);
 		}
 	}
+
+	Elements.ForEachElementInRange(
+		FirstVisibleElement,
+		NumVisibleElements,
+		[&](int32 ElementIndex, const FProperty* KeyProperty, void* KeyPointer, const FProperty* ElementProperty, void* ElementPointer)
+		{
+			const int32 VisibleIndex = ElementIndex - FirstVisibleElement;
+			const uint32 ElementHash = FPropertyValueHasher::HashValue(ElementProperty, ElementPointer);
+			const bool bWasShown = (VisibleIndex < PreviousNumVisibleElements);
+
+			// Elements that are only being shown because the page changed should not be highlighted.
+			bool bElementChanged = !bPageChanged;
+
+			if (bIsKeyed)
+			{
+				const uint32 KeyHash = (KeyProperty != nullptr) ?
+					FPropertyValueHasher::HashValue(KeyProperty, KeyPointer) :
+					ElementHash;
+
+				if (bWasShown && 
+					ContainerState.ElementKeyHashes[VisibleIndex] == KeyHash && 
+					ContainerState.ElementHashes[VisibleIndex] == ElementHash)
+				{
+					return;
+				}
+
+				// An element that only moved to another position, because a key before it was added or
+				// removed, is shown at its new position without being highlighted.
+				const uint32* PreviousElementHash = PreviousKeyedElementHashes.Find(KeyHash);
+				bElementChanged &= (PreviousElementHash == nullptr || *PreviousElementHash != ElementHash);
+				ContainerState.ElementKeyHashes[VisibleIndex] = KeyHash;
+			}
+			else
+			{
+				if (bWasShown && ContainerState.ElementHashes[VisibleIndex] == ElementHash)
+				{
+					return;
+				}
+
+				bContainerChanged |= bElementChanged;
+			}
+
+			ContainerState.ElementHashes[VisibleIndex] = ElementHash;
+			ContainerState.ElementUpdateTimes[VisibleIndex] = bElementChanged ? RealTimeInSeconds : 0.0;
+
+			FText NameText;
+
+			if (KeyProperty != nullptr)
+			{
+				FFastPropertyInstanceInfo KeyInfo{ 
+					KeyPointer, 
+					KeyProperty, 
+					FFastPropertyInstanceInfo::value_pointer_marker{} };
+
+				NameText = FText::Format(
+					FTextFormat::FromString(TEXT("[\"{0}\"] ")),
+					{ 
+						KeyInfo.GetValue()
+					});
+			}
+
+			FFastPropertyInstanceInfo ElementInfo{ 
+				ElementPointer, 
+				ElementProperty, 
+				FFastPropertyInstanceInfo::value_pointer_marker{} };
+
+			const FText ValueText = GetValueText(ElementInfo);
+
+			if (ValueWidget != nullptr)
+			{
+				ValueWidget->SetElementText(VisibleIndex, NameText, ValueText);
+			}
+		});
+
+	return bContainerChanged;
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::OnContainerPageChanged(int32 CellIndex)
+{
+	if (!World.IsValid() || ClassLayout->IsStale() || !ResolveActors())
+	{
+		return;
+	}
+
+	const int32 RowIndex = CellIndex / State->Rows.NumInstances();
+	const int32 InstanceIndex = CellIndex % State->Rows.NumInstances();
+
+	if (ResolvedActors[InstanceIndex] == nullptr)
+	{
+		return;
+	}
+
+	// The new page is filled in right away rather than on the next poll of the row, which may be
+	// seconds away, or never without live updates.
+	UpdateContainerElements(RowIndex, InstanceIndex, World->GetRealTimeSeconds());
+
+	// Keep the row polled at full rate while the user is paging through it.
+	if (bIsRegisteredForUpdates)
+	{
+		State->Scheduler.MarkRowChanged(RowIndex, World->GetRealTimeSeconds());
+	}
 }
 
-FString FLiveBlueprintDebuggerDetailCustomization::GetPropertyCategoryString(FProperty* Property)
+void FLiveBlueprintDebuggerDetailCustomization::OnReferenceExpanderClicked(int32 ElementIndex, int32 CellIndex)
 {
-    FString Category = c_PrivateCategoryName;
-    
-    auto MetaDataMap = Property->GetMetaDataMap();
-    
-    if (MetaDataMap != nullptr &&
-        MetaDataMap->Contains(FName("Category")))
-    {
-        Category = *(MetaDataMap->Find(FName("Category")));
-		Category.ReplaceInline(TEXT("|"), TEXT(" "));
-    }
+	if (!World.IsValid() || ClassLayout->IsStale() || !ResolveActors())
+	{
+		return;
+	}
+
+	const int32 RowIndex = CellIndex / State->Rows.NumInstances();
+	const int32 InstanceIndex = CellIndex % State->Rows.NumInstances();
+	UObject* Object = ResolvedActors[InstanceIndex];
+	SLiveBlueprintValueWidget& ValueWidget = *State->Rows.ValueWidgets[CellIndex];
+
+	if (Object == nullptr)
+	{
+		return;
+	}
+
+	// The reference of the row itself toggles the whole expansion. Anything below it only expands or
+	// collapses one level.
+	if (ElementIndex == INDEX_NONE)
+	{
+		if (ReferenceExpansions.Remove(CellIndex) > 0)
+		{
+			ValueWidget.SetExpanded(false);
+			return;
+		}
+
+		UObject* ReferencedObject = FLiveBlueprintReferenceExpansion::GetReferencedObject(
+			State->Rows.Properties[RowIndex],
+			State->Rows.GetValuePointer(RowIndex, Object));
+
+		if (ReferencedObject == nullptr)
+		{
+			return;
+		}
+
+		ReferenceExpansions.Add(CellIndex).ExpandRoot(ReferencedObject);
+		ValueWidget.SetExpanded(true);
+	}
+	else
+	{
+		FLiveBlueprintReferenceExpansion* Expansion = ReferenceExpansions.Find(CellIndex);
+
+		if (Expansion == nullptr || ElementIndex >= Expansion->Num())
+		{
+			return;
+		}
+
+		if (Expansion->IsStale())
+		{
+			ReferenceExpansions.Remove(CellIndex);
+			ValueWidget.SetExpanded(false);
+			return;
+		}
+
+		if (Expansion->GetNode(ElementIndex).bIsExpanded)
+		{
+			Expansion->Collapse(ElementIndex);
+		}
+		else if (!Expansion->Expand(ElementIndex))
+		{
+			return;
+		}
+	}
+
+	RefreshReferenceExpansion(CellIndex);
+
+	// Keep the row polled at full rate while the user is looking at what they just expanded.
+	if (bIsRegisteredForUpdates)
+	{
+		State->Scheduler.MarkRowChanged(RowIndex, World->GetRealTimeSeconds());
+	}
+}
+
+bool FLiveBlueprintDebuggerDetailCustomization::UpdateReferenceExpansion(
+	int32 RowIndex,
+	int32 InstanceIndex,
+	bool bReferenceChanged,
+	double RealTimeInSeconds)
+{
+	const int32 CellIndex = State->Rows.GetCellIndex(RowIndex, InstanceIndex);
+	FLiveBlueprintReferenceExpansion* Expansion = ReferenceExpansions.Find(CellIndex);
+
+	if (Expansion == nullptr)
+	{
+		return false;
+	}
+
+	SLiveBlueprintValueWidget& ValueWidget = *State->Rows.ValueWidgets[CellIndex];
+
+	if (Expansion->IsStale())
+	{
+		ReferenceExpansions.Remove(CellIndex);
+		ValueWidget.SetExpanded(false);
+		return true;
+	}
+
+	// A row that now refers to another object shows the members of the new one, expanded one level.
+	if (bReferenceChanged)
+	{
+		UObject* ReferencedObject = FLiveBlueprintReferenceExpansion::GetReferencedObject(
+			State->Rows.Properties[RowIndex],
+			State->Rows.GetValuePointer(RowIndex, ResolvedActors[InstanceIndex]));
+
+		if (ReferencedObject == nullptr)
+		{
+			ReferenceExpansions.Remove(CellIndex);
+			ValueWidget.SetExpanded(false);
+			return true;
+		}
+
+		Expansion->ExpandRoot(ReferencedObject);
+		RefreshReferenceExpansion(CellIndex);
+		return true;
+	}
+
+	LIVE_BLUEPRINT_SCOPE(UpdateReferenceExpansion);
+
+	bool bExpansionChanged = false;
+	bool bNodesChanged = false;
+
+	for (int32 NodeIndex = 0; NodeIndex < Expansion->Num(); NodeIndex++)
+	{
+		FLiveBlueprintReferenceExpansion::FNode& Node = Expansion->GetNode(NodeIndex);
+
+		if (Node.bIsNote)
+		{
+			continue;
+		}
+
+		// Members of destroyed objects are hashed as zero, so that they are shown as destroyed once.
+		const FLiveBlueprintPropertyLayout& PropertyLayout = Node.ClassLayout->GetProperties()[Node.PropertyIndex];
+		const void* ValuePointer = Expansion->GetValuePointer(NodeIndex);
+		const uint32 NewValueHash = (ValuePointer != nullptr) ?
+			PropertyLayout.Accessor.Hash(PropertyLayout.Property, ValuePointer) :
+			0;
+
+		if (NewValueHash == Node.ValueHash)
+		{
+			continue;
+		}
+
+		Node.ValueHash = NewValueHash;
+		Node.LastUpdateTime = RealTimeInSeconds;
+		bExpansionChanged = true;
+
+		// An expanded member that now refers to another object is expanded again for the new one.
+		// This changes which nodes follow it, so all of them are refreshed below.
+		if (Node.bIsExpanded)
+		{
+			Expansion->Collapse(NodeIndex);
+			Expansion->Expand(NodeIndex);
+			bNodesChanged = true;
+		}
+		else if (!bNodesChanged)
+		{
+			ValueWidget.SetElementHighlightColor(NodeIndex, FLinearColor::Transparent);
+			SetReferenceMemberWidgets(ValueWidget, *Expansion, NodeIndex);
+		}
+	}
+
+	if (bNodesChanged)
+	{
+		RefreshReferenceExpansion(CellIndex);
+	}
+
+	return bExpansionChanged;
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::RefreshReferenceExpansion(int32 CellIndex)
+{
+	const FLiveBlueprintReferenceExpansion& Expansion = ReferenceExpansions.FindChecked(CellIndex);
+	SLiveBlueprintValueWidget& ValueWidget = *State->Rows.ValueWidgets[CellIndex];
+
+	ValueWidget.SetNumElements(Expansion.Num());
+
+	// Element widgets are reused for whichever node now has their index, so they start without the
+	// highlight of the node they showed before.
+	for (int32 NodeIndex = 0; NodeIndex < Expansion.Num(); NodeIndex++)
+	{
+		ValueWidget.SetElementHighlightColor(NodeIndex, FLinearColor::Transparent);
+		SetReferenceMemberWidgets(ValueWidget, Expansion, NodeIndex);
+	}
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::SetReferenceMemberWidgets(
+	SLiveBlueprintValueWidget& ValueWidget,
+	const FLiveBlueprintReferenceExpansion& Expansion,
+	int32 NodeIndex)
+{
+	const FLiveBlueprintReferenceExpansion::FNode& Node = Expansion.GetNode(NodeIndex);
+
+	if (Node.bIsNote)
+	{
+		ValueWidget.SetElementText(
+			NodeIndex,
+			FText::GetEmpty(),
+			FText::Format(LOCTEXT("MoreMembers", "{0} more variables, click to show"), FText::AsNumber(Node.NumHiddenMembers)));
+		ValueWidget.SetElementExpander(NodeIndex, Node.Depth, SLiveBlueprintValueWidget::EExpander::Collapsed);
+		return;
+	}
+
+	const FLiveBlueprintPropertyLayout& PropertyLayout = Node.ClassLayout->GetProperties()[Node.PropertyIndex];
+	void* ValuePointer = Expansion.GetValuePointer(NodeIndex);
+	const FText NameText = FText::Format(LOCTEXT("MemberName", "{0}: "), PropertyLayout.DisplayName);
+
+	if (ValuePointer == nullptr)
+	{
+		ValueWidget.SetElementText(NodeIndex, NameText, LOCTEXT("DestroyedMember", "[destroyed]"));
+		ValueWidget.SetElementExpander(NodeIndex, Node.Depth, SLiveBlueprintValueWidget::EExpander::None);
+		return;
+	}
+
+	FText ValueText = GetValueText(FFastPropertyInstanceInfo{
+		ValuePointer,
+		PropertyLayout.Property,
+		FFastPropertyInstanceInfo::value_pointer_marker{} });
+
+	// References to objects that are already expanded can't be expanded again, since that could
+	// follow a reference cycle forever.
+	SLiveBlueprintValueWidget::EExpander Expander = SLiveBlueprintValueWidget::EExpander::None;
+
+	if (Expansion.IsExpandedElsewhere(NodeIndex))
+	{
+		ValueText = FText::Format(LOCTEXT("ExpandedAbove", "{0} (expanded above)"), ValueText);
+	}
+	else if (Expansion.GetReferencedObject(NodeIndex) != nullptr)
+	{
+		Expander = Node.bIsExpanded ?
+			SLiveBlueprintValueWidget::EExpander::Expanded :
+			SLiveBlueprintValueWidget::EExpander::Collapsed;
+	}
+
+	ValueWidget.SetElementText(NodeIndex, NameText, ValueText);
+	ValueWidget.SetElementExpander(NodeIndex, Node.Depth, Expander);
+}
+
+bool FLiveBlueprintDebuggerDetailCustomization::UpdateWidgetRow(
+	int32 RowIndex,
+	bool bIsShown,
+	double RealTimeInSeconds)
+{
+	if (State->PendingRows[RowIndex])
+	{
+		// A pending row is polled because the header of one of its groups is shown, even while the
+		// group is collapsed. Until the row itself is shown, it is only hashed to keep that header
+		// up-to-date.
+		if (!bIsShown)
+		{
+			return UpdatePendingWidgetRow(RowIndex);
+		}
+
+		// This is the first time the row is shown, so fill in its values without highlighting them.
+		State->PendingRows[RowIndex] = false;
+
+		for (int32 InstanceIndex = 0; InstanceIndex < State->Rows.NumInstances(); InstanceIndex++)
+		{
+			FillInWidgetCell(RowIndex, InstanceIndex, RealTimeInSeconds);
+		}
+
+		return false;
+	}
+
+	// All of the selected actors are updated together, so the scheduler treats the row as changed
+	// if the value changed for any of them.
+	bool bRowChanged = false;
+
+	for (int32 InstanceIndex = 0; InstanceIndex < State->Rows.NumInstances(); InstanceIndex++)
+	{
+		bRowChanged |= UpdateWidgetCell(RowIndex, InstanceIndex, RealTimeInSeconds);
+	}
+
+	return bRowChanged;
+}
+
+bool FLiveBlueprintDebuggerDetailCustomization::UpdatePendingWidgetRow(int32 RowIndex)
+{
+	bool bRowChanged = false;
+
+	for (int32 InstanceIndex = 0; InstanceIndex < State->Rows.NumInstances(); InstanceIndex++)
+	{
+		const int32 CellIndex = State->Rows.GetCellIndex(RowIndex, InstanceIndex);
+
+		if (ResolvedActors[InstanceIndex] == nullptr ||
+			(State->SnapshotDiffer.IsRowDiffed(RowIndex) && !State->SnapshotDiffer.ConsumeChange(CellIndex)))
+		{
+			continue;
+		}
+
+		const uint32 NewValueHash = ReadValueHash(RowIndex, InstanceIndex);
+
+		if (NewValueHash != State->Rows.ValueHashes[CellIndex])
+		{
+			State->Rows.ValueHashes[CellIndex] = NewValueHash;
+			MarkParentGroupsChanged(RowIndex, InstanceIndex);
+			bRowChanged = true;
+		}
+	}
+
+	return bRowChanged;
+}
+
+bool FLiveBlueprintDebuggerDetailCustomization::UpdateWidgetCell(
+	int32 RowIndex,
+	int32 InstanceIndex,
+	double RealTimeInSeconds)
+{
+	UObject* Object = ResolvedActors[InstanceIndex];
+
+	if (Object == nullptr)
+	{
+		return false;
+	}
+
+	const int32 CellIndex = State->Rows.GetCellIndex(RowIndex, InstanceIndex);
+	bool bCellChanged = false;
+	bool bExpansionChanged = false;
+
+	if (State->Rows.IsContainerRow(RowIndex))
+	{
+		bCellChanged = UpdateContainerElements(RowIndex, InstanceIndex, RealTimeInSeconds);
+		RecordCellValue(RowIndex, InstanceIndex, false);
+	}
+	else
+	{
+		if (!State->SnapshotDiffer.IsRowDiffed(RowIndex) || State->SnapshotDiffer.ConsumeChange(CellIndex))
+		{
+			uint32 NewValueHash = ReadValueHash(RowIndex, InstanceIndex);
+			bCellChanged = (NewValueHash != State->Rows.ValueHashes[CellIndex]);
+			State->Rows.ValueHashes[CellIndex] = NewValueHash;
+
+			if (bCellChanged)
+			{
+				QueueWidgetCellValue(RowIndex, InstanceIndex);
+				RecordHistorySample(RowIndex, InstanceIndex, RealTimeInSeconds);
+				RecordCellValue(RowIndex, InstanceIndex, false);
+				State->Rows.LastUpdateTimes[CellIndex] = RealTimeInSeconds;
+			}
+		}
+
+		// The members of an expanded reference live in other objects, which the snapshot of the
+		// actor doesn't cover, so they are polled even if the reference itself did not change.
+		if (ReferenceExpansions.Num() > 0)
+		{
+			bExpansionChanged = UpdateReferenceExpansion(RowIndex, InstanceIndex, bCellChanged, RealTimeInSeconds);
+		}
+	}
+
+	// The members of an expanded reference are not part of the value of the groups the row is in.
+	if (bCellChanged)
+	{
+		MarkParentGroupsChanged(RowIndex, InstanceIndex);
+	}
+
+	return bCellChanged || bExpansionChanged;
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::MarkParentGroupsChanged(int32 RowIndex, int32 InstanceIndex)
+{
+	for (int32 ParentIndex = State->Rows.ParentIndices[RowIndex]; 
+		ParentIndex != INDEX_NONE; 
+		ParentIndex = State->Rows.ParentIndices[ParentIndex])
+	{
+		State->ChangedGroupCells[State->Rows.GetCellIndex(ParentIndex, InstanceIndex)] = true;
+	}
+}
+
+void FLiveBlueprintDebuggerDetailCustomization::UpdateHighlights(double RealTimeInSeconds)
+{
+	LIVE_BLUEPRINT_SCOPE(UpdateHighlights);
+
+	const ULiveBlueprintDebuggerSettings* Settings = GetDefault<ULiveBlueprintDebuggerSettings>();
+
+	if (!bHasWidgets || !Settings->bHighlightValuesThatHaveChanged)
+	{
+		return;
+	}
+
+	// Only rows that changed recently can still have a visible highlight.
+	for (int32 RowIndex : State->Scheduler.GetHotRows())
+	{
+		for (int32 InstanceIndex = 0; InstanceIndex < State->Rows.NumInstances(); InstanceIndex++)
+		{
+			const int32 CellIndex = State->Rows.GetCellIndex(RowIndex, InstanceIndex);
+			SLiveBlueprintValueWidget& ValueWidget = *State->Rows.ValueWidgets[CellIndex];
+			FLinearColor HighlightColor;
+
+			if (GetHighlightColor(RealTimeInSeconds - State->Rows.LastUpdateTimes[CellIndex], HighlightColor))
+			{
+				ValueWidget.SetHighlightColor(HighlightColor);
+			}
+
+			if (State->Rows.IsContainerRow(RowIndex))
+			{
+				const FLiveBlueprintContainerState& ContainerState = 
+					State->Rows.ContainerStates[State->Rows.ContainerStateIndices[CellIndex]];
+
+				for (int32 ElementIndex = 0; ElementIndex < ContainerState.ElementUpdateTimes.Num(); ElementIndex++)
+				{
+					if (GetHighlightColor(RealTimeInSeconds - ContainerState.ElementUpdateTimes[ElementIndex], HighlightColor))
+					{
+						ValueWidget.SetElementHighlightColor(ElementIndex, HighlightColor);
+					}
+				}
+			}
+			else if (const FLiveBlueprintReferenceExpansion* Expansion = ReferenceExpansions.Find(CellIndex))
+			{
+				for (int32 NodeIndex = 0; NodeIndex < Expansion->Num(); NodeIndex++)
+				{
+					if (GetHighlightColor(RealTimeInSeconds - Expansion->GetNode(NodeIndex).LastUpdateTime, HighlightColor))
+					{
+						ValueWidget.SetElementHighlightColor(NodeIndex, HighlightColor);
+					}
+				}
+			}
+		}
+	}
+}
+
+bool FLiveBlueprintDebuggerDetailCustomization::GetHighlightColor(
+	double TimeSincePropertyChanged, 
+	FLinearColor& HighlightColor)
+{
+	if (TimeSincePropertyChanged > 2.0)
+	{
+		return false;
+	}
+
+	const ULiveBlueprintDebuggerSettings* Settings = GetDefault<ULiveBlueprintDebuggerSettings>();
 
-    return Category;
+	HighlightColor = Settings->PropertyChangedHighlightColor;
+	HighlightColor.A = HighlightColor.A * (1.0f - static_cast<float>(std::clamp(TimeSincePropertyChanged, 0.0, 1.0)));
+	return true;
 }
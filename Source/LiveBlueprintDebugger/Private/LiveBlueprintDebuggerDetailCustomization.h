@@ -6,20 +6,11 @@
 #include "IDetailCustomization.h"
 
 #include "FastPropertyInstanceInfo.h"
+#include "LiveBlueprintReferenceExpansion.h"
+#include "LiveBlueprintSelectionState.h"
+#include "LiveBlueprintValueFormatter.h"
 
-struct FLiveBlueprintWidgetRowData
-{
-	FLiveBlueprintWidgetRowData(FFastPropertyInstanceInfo& PropertyInstanceInfo) :
-		PropertyInstanceInfo(PropertyInstanceInfo)
-	{
-	}
-
-	FFastPropertyInstanceInfo PropertyInstanceInfo;
-	double LastUpdateTimeInSeconds = 0.0;
-	uint32 ValueHash = 0;
-	TSharedPtr<class SBorder> ValueBorderWidget;
-	TSharedPtr<class SHorizontalBox> ValueWidgetContainer;
-};
+class SLiveBlueprintValueWidget;
 
 /**
  * Adds additional detail customizations for any Actor class that also has Blueprint variables.
@@ -28,36 +19,145 @@ class FLiveBlueprintDebuggerDetailCustomization
 {
 public:
 	static TUniquePtr<FLiveBlueprintDebuggerDetailCustomization> CreateForLayoutBuilder(
-		IDetailLayoutBuilder& LayoutBuilder);
+		IDetailLayoutBuilder& LayoutBuilder,
+		FLiveBlueprintSelectionStateCache& StateCache);
+
+	// Creates a customization that updates its rows without a details panel or any widgets, which is
+	// used by the benchmark commandlet. It is not registered with FLiveBlueprintUpdateDriver, so
+	// UpdateBlueprintDetails has to be called by the owner. The first NumRowsShown rows count as
+	// shown and every other row counts as scrolled out of view.
+	static TUniquePtr<FLiveBlueprintDebuggerDetailCustomization> CreateWithoutWidgets(
+		const TArray<TWeakObjectPtr<AActor>>& Actors,
+		FLiveBlueprintSelectionStateCache& StateCache,
+		int32 NumRowsShown);
 
 private:
-	static TWeakObjectPtr<AActor> GetActorToCustomize(IDetailLayoutBuilder& LayoutBuilder);
+	static TArray<TWeakObjectPtr<AActor>> GetActorsToCustomize(IDetailLayoutBuilder& LayoutBuilder);
+	static bool HasLiveUpdates(const class UWorld* World);
 	static bool IsAnyAncestorABlueprintClass(UClass* Class);
 
 private:
-	FLiveBlueprintDebuggerDetailCustomization(TWeakObjectPtr<AActor> ActorToCustomize, IDetailLayoutBuilder& LayoutBuilder);
+	FLiveBlueprintDebuggerDetailCustomization(
+		const TArray<TWeakObjectPtr<AActor>>& ActorsToCustomize, 
+		IDetailLayoutBuilder& LayoutBuilder,
+		const TSharedRef<FLiveBlueprintSelectionState>& InState);
+	FLiveBlueprintDebuggerDetailCustomization(
+		const TArray<TWeakObjectPtr<AActor>>& ActorsToCustomize, 
+		const TSharedRef<FLiveBlueprintSelectionState>& InState,
+		int32 NumRowsShown);
 public:
 	~FLiveBlueprintDebuggerDetailCustomization();
+
+	// Called once per frame by FLiveBlueprintUpdateDriver while live updates are enabled.
+	void UpdateBlueprintDetails();
+
+	// Called by FLiveBlueprintUpdateDriver before a Blueprint is compiled, since the compile can free
+	// properties that are still being formatted on a worker thread.
+	void WaitForFormatting();
+
+	bool IsShownIn(const class IDetailsView* InDetailsView) const;
+	bool IsDetailsViewOpen() const;
+
+	struct FUpdateCounts
+	{
+		int32 NumRowsPolled = 0;
+		int32 NumRowsUpdated = 0;
+		int32 NumRowsSkipped = 0;
+	};
+
+	const FUpdateCounts& GetLastUpdateCounts() const;
+	SIZE_T GetAllocatedSize() const;
 	
 private:
-	void UpdateBlueprintDetails();
+	void InitializeState(bool bHasLiveUpdates);
+	bool ResolveActors();
+	const float* FindRefreshRateOverride(int32 RowIndex) const;
+	uint32 ReadValueHash(int32 RowIndex, int32 InstanceIndex);
+	bool IsRowVisible(int32 RowIndex, double SlateTimeInSeconds) const;
+	bool IsRowShown(int32 RowIndex, double SlateTimeInSeconds) const;
+	bool SyncWithRecorder();
+	void RecordCellValue(int32 RowIndex, int32 InstanceIndex, bool bForce);
 
 	void ExpandPropertyChildren(
 		class IDetailGroup& Group, 
-		FFastPropertyInstanceInfo& PropertyInstanceInfo,
-		int LevelsOfRecursion = 0);
+		int32 GroupRowIndex);
 	
-	static void FillInWidgetRow(FDetailWidgetRow& WidgetRow, FLiveBlueprintWidgetRowData& WidgetRowData, int LogIndentation = 0);
-	static TSharedRef<class SWidget> GenerateNameIcon(const FFastPropertyInstanceInfo& PropertyInstanceInfo);
-	static TSharedRef<class SWidget> GenerateNameWidget(const FFastPropertyInstanceInfo& PropertyInstanceInfo);
-	static TSharedRef<class SWidget> GenerateValueWidget(const FFastPropertyInstanceInfo& PropertyInstanceInfo);
-	static void UpdateWidgetRowValue(FLiveBlueprintWidgetRowData& WidgetRowData);
-	static void UpdateWidgetRow(FLiveBlueprintWidgetRowData& LiveBlueprintWidgetRow, double RealTimeInSeconds);
-	static FString GetPropertyCategoryString(FProperty* Property);
-
-	TWeakObjectPtr<AActor> Actor;
-	TArray<FLiveBlueprintWidgetRowData> WidgetRows;
-	FTimerHandle UpdateTimerHandle;
+	void FillInWidgetRow(FDetailWidgetRow& WidgetRow, int32 RowIndex);
+	void FillInWidgetCell(int32 RowIndex, int32 InstanceIndex, double RealTimeInSeconds);
+	void RebindWidgetCell(int32 RowIndex, int32 InstanceIndex);
+	void RecordHistorySample(int32 RowIndex, int32 InstanceIndex, double RealTimeInSeconds);
+	TSharedRef<class SWidget> GenerateValueWidgets(int32 RowIndex);
+	FFastPropertyInstanceInfo GetPropertyInstanceInfo(int32 RowIndex, int32 InstanceIndex) const;
+	static TSharedRef<class SWidget> GenerateNameIcon(const struct FLiveBlueprintPropertyLayout& PropertyLayout);
+	static TSharedRef<class SWidget> GenerateNameWidget(const FText& DisplayName);
+	static FText GetValueText(const FFastPropertyInstanceInfo& PropertyInstanceInfo);
+	void UpdateWidgetCellValue(int32 RowIndex, int32 InstanceIndex);
+	void SetWidgetCellValue(int32 CellIndex, const FText& ValueText);
+	void QueueWidgetCellValue(int32 RowIndex, int32 InstanceIndex);
+	bool UpdateContainerElements(int32 RowIndex, int32 InstanceIndex, double RealTimeInSeconds);
+	void OnContainerPageChanged(int32 CellIndex);
+	void OnReferenceExpanderClicked(int32 ElementIndex, int32 CellIndex);
+	bool UpdateReferenceExpansion(int32 RowIndex, int32 InstanceIndex, bool bReferenceChanged, double RealTimeInSeconds);
+	void RefreshReferenceExpansion(int32 CellIndex);
+	void SetReferenceMemberWidgets(SLiveBlueprintValueWidget& ValueWidget, const FLiveBlueprintReferenceExpansion& Expansion, int32 NodeIndex);
+	bool UpdateWidgetRow(int32 RowIndex, bool bIsShown, double RealTimeInSeconds);
+	bool UpdatePendingWidgetRow(int32 RowIndex);
+	bool UpdateWidgetCell(int32 RowIndex, int32 InstanceIndex, double RealTimeInSeconds);
+	void MarkParentGroupsChanged(int32 RowIndex, int32 InstanceIndex);
+	void UpdateHighlights(double RealTimeInSeconds);
+	void UpdateMemoryStats();
+	void AddOverheadSample(double DurationInSeconds, int32 NumRowsUpdated, int32 NumRowsSkipped, double RealTimeInSeconds);
+	FText GetOverheadText() const;
+	static bool GetHighlightColor(double TimeSincePropertyChanged, FLinearColor& HighlightColor);
+
+	// All of the selected actors have the same class. ResolvedActors caches the result of resolving
+	// the weak pointers once per update, and holds nullptr for actors that were destroyed.
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	TArray<AActor*> ResolvedActors;
+	TWeakObjectPtr<UWorld> World;
+	TSharedPtr<const class FLiveBlueprintClassLayout> ClassLayout;
+
+	// The rows and everything else that outlives the widgets of one details panel. bRebindWidgets is
+	// true when the state was already filled in by an earlier customization of the same actors.
+	TSharedRef<FLiveBlueprintSelectionState> State;
+	const bool bRebindWidgets;
+
+	// Without widgets, visibility can't be checked, so the first NumRowsShownWithoutWidgets rows are
+	// treated as shown.
+	const bool bHasWidgets;
+	const int32 NumRowsShownWithoutWidgets = 0;
+	FUpdateCounts LastUpdateCounts;
+
+	FLiveBlueprintValueFormatter ValueFormatter;
+	bool bIsRegisteredForUpdates = false;
+
+	// The expanded object and interface cells, keyed by cell. Expansions belong to the widgets they
+	// are shown in, so they are not kept in the cached state.
+	TMap<int32, FLiveBlueprintReferenceExpansion> ReferenceExpansions;
+
+	// The details panel that shows this customization. A panel can be closed without being
+	// customized again, so it is only held weakly.
+	const class IDetailsView* DetailsViewKey = nullptr;
+	TWeakPtr<const class SWidget> DetailsView;
+
+	// The cost of the last NumOverheadSamples updates, shown in the overhead row when it is enabled.
+	// The text of the row is only reformatted every OverheadTextRefreshPeriod seconds.
+	struct FOverheadSample
+	{
+		double DurationInSeconds = 0.0;
+		int32 NumRowsUpdated = 0;
+		int32 NumRowsSkipped = 0;
+	};
+
+	static constexpr int32 NumOverheadSamples = 60;
+	static constexpr double OverheadTextRefreshPeriod = 0.5;
+	TArray<FOverheadSample> OverheadSamples;
+	FOverheadSample OverheadSampleSums;
+	int32 NextOverheadSample = 0;
+	int32 NumOverheadSamplesAdded = 0;
+	double LastOverheadTextTime = 0.0;
+	TSharedPtr<class STextBlock> OverheadTextBlock;
+
 	TSharedPtr<class SKismetDebugTreeView> DebugTreeWidget;
 	TSharedPtr<class FDebugLineItem> RootDebugTreeItem;
 };
\ No newline at end of file
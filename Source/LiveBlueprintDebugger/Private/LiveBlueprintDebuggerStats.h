@@ -0,0 +1,46 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+// Stats for the debugger's own cost, shown with "stat LiveBlueprintDebugger".
+//
+// LIVE_BLUEPRINT_SCOPE(Name) starts both the cycle stat STAT_LiveBlueprint_<Name> and a CPU trace
+// scope named LiveBlueprint_<Name>, so the same work also shows up as timing events in Unreal
+// Insights, next to the game code that runs in the same frame. The row counters and the row memory
+// are traced as Insights counters too. Everything is defined in LiveBlueprintDebugger.cpp.
+
+DECLARE_STATS_GROUP(TEXT("LiveBlueprintDebugger"), STATGROUP_LiveBlueprintDebugger, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Construct Customization"), STAT_LiveBlueprint_Construct, STATGROUP_LiveBlueprintDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Class Layout"), STAT_LiveBlueprint_BuildClassLayout, STATGROUP_LiveBlueprintDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Widget Rows"), STAT_LiveBlueprint_BuildWidgetRows, STATGROUP_LiveBlueprintDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update"), STAT_LiveBlueprint_Update, STATGROUP_LiveBlueprintDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Poll Rows"), STAT_LiveBlueprint_PollRows, STATGROUP_LiveBlueprintDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Diff Snapshots"), STAT_LiveBlueprint_DiffSnapshots, STATGROUP_LiveBlueprintDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Format Value"), STAT_LiveBlueprint_FormatValue, STATGROUP_LiveBlueprintDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Format Value (Worker Thread)"), STAT_LiveBlueprint_FormatValueOnWorker, STATGROUP_LiveBlueprintDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Populate Children"), STAT_LiveBlueprint_PopulateChildren, STATGROUP_LiveBlueprintDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Container Elements"), STAT_LiveBlueprint_UpdateContainerElements, STATGROUP_LiveBlueprintDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Group Rows"), STAT_LiveBlueprint_UpdateGroupRows, STATGROUP_LiveBlueprintDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Highlights"), STAT_LiveBlueprint_UpdateHighlights, STATGROUP_LiveBlueprintDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Reference Expansion"), STAT_LiveBlueprint_UpdateReferenceExpansion, STATGROUP_LiveBlueprintDebugger, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Rows Polled"), STAT_LiveBlueprint_RowsPolled, STATGROUP_LiveBlueprintDebugger, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Rows Updated"), STAT_LiveBlueprint_RowsUpdated, STATGROUP_LiveBlueprintDebugger, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Rows Skipped (Not Visible)"), STAT_LiveBlueprint_RowsSkipped, STATGROUP_LiveBlueprintDebugger, );
+
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Row Memory"), STAT_LiveBlueprint_RowMemory, STATGROUP_LiveBlueprintDebugger, );
+
+TRACE_DECLARE_INT_COUNTER_EXTERN(LiveBlueprint_RowsPolled);
+TRACE_DECLARE_INT_COUNTER_EXTERN(LiveBlueprint_RowsUpdated);
+TRACE_DECLARE_INT_COUNTER_EXTERN(LiveBlueprint_RowsSkipped);
+TRACE_DECLARE_MEMORY_COUNTER_EXTERN(LiveBlueprint_RowMemory);
+
+#define LIVE_BLUEPRINT_SCOPE(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_LiveBlueprint_##Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(LiveBlueprint_##Name)
@@ -0,0 +1,296 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "LiveBlueprintInstanceTable.h"
+
+#include "EngineUtils.h"
+#include "FastPropertyInstanceInfo.h"
+#include "HAL/PlatformTime.h"
+#include "LiveBlueprintClassLayout.h"
+#include "LiveBlueprintValueHistory.h"
+
+// The number of cells that are updated between checks of the time budget.
+static constexpr int32 c_CellsPerBudgetCheck = 64;
+
+void FLiveBlueprintInstanceTable::Reset(UWorld* InWorld, UClass* InClass)
+{
+	World = InWorld;
+	Class = InClass;
+	ClassLayout.Reset();
+	Columns.Reset();
+	Instances.Reset();
+	InstanceNames.Reset();
+	KnownInstances.Reset();
+	ResolvedInstances.Reset();
+	CursorColumn = 0;
+	CursorInstance = 0;
+
+	if (InWorld == nullptr || InClass == nullptr)
+	{
+		return;
+	}
+
+	// Only top-level variables get a column. Struct variables show the same one-level summary as
+	// their group header row in the details panel.
+	ClassLayout = FLiveBlueprintClassLayoutCache::Get().FindOrBuild(InClass);
+
+	for (const FLiveBlueprintPropertyLayout& PropertyLayout : ClassLayout->GetProperties())
+	{
+		if (PropertyLayout.ParentIndex != INDEX_NONE)
+		{
+			continue;
+		}
+
+		FColumn& Column = Columns.AddDefaulted_GetRef();
+		Column.Property = PropertyLayout.Property;
+		Column.Offset = PropertyLayout.Offset;
+		Column.ValueKind = PropertyLayout.ValueKind;
+		Column.Accessor = PropertyLayout.Accessor;
+		Column.DisplayName = PropertyLayout.DisplayName;
+		Column.bIsNumeric = FLiveBlueprintValueHistory::IsNumericProperty(PropertyLayout.Property);
+	}
+
+	ScanInstances();
+}
+
+UWorld* FLiveBlueprintInstanceTable::GetWorld() const
+{
+	return World.Get();
+}
+
+UClass* FLiveBlueprintInstanceTable::GetClass() const
+{
+	return Class.Get();
+}
+
+bool FLiveBlueprintInstanceTable::IsStale() const
+{
+	// The property pointers of a stale layout may no longer be valid.
+	return ClassLayout.IsValid() && (ClassLayout->IsStale() || !Class.IsValid());
+}
+
+bool FLiveBlueprintInstanceTable::ScanInstances()
+{
+	if (!World.IsValid() || !Class.IsValid() || IsStale())
+	{
+		return false;
+	}
+
+	bool bInstancesChanged = false;
+
+	for (int32 InstanceIndex = Instances.Num() - 1; InstanceIndex >= 0; InstanceIndex--)
+	{
+		if (!Instances[InstanceIndex].IsValid())
+		{
+			RemoveInstanceAtSwap(InstanceIndex);
+			bInstancesChanged = true;
+		}
+	}
+
+	for (TActorIterator<AActor> It(World.Get(), Class.Get()); It; ++It)
+	{
+		if (!KnownInstances.Contains(*It))
+		{
+			AddInstance(*It);
+			bInstancesChanged = true;
+		}
+	}
+
+	return bInstancesChanged;
+}
+
+bool FLiveBlueprintInstanceTable::Tick(double BudgetInSeconds, int32 ColumnToWatch)
+{
+	const int32 NumInstances = Instances.Num();
+
+	if (NumInstances == 0 || Columns.Num() == 0 || IsStale())
+	{
+		return false;
+	}
+
+	ResolvedInstances.SetNum(NumInstances);
+
+	for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; InstanceIndex++)
+	{
+		ResolvedInstances[InstanceIndex] = Instances[InstanceIndex].Get();
+	}
+
+	const double BudgetEndTime = FPlatformTime::Seconds() + BudgetInSeconds;
+	bool bWatchedColumnChanged = false;
+
+	// Visit every cell at most once per tick.
+	for (int32 NumCellsLeft = Columns.Num() * NumInstances; NumCellsLeft > 0;)
+	{
+		FColumn& Column = Columns[CursorColumn];
+		const int32 EndInstance = FMath::Min(CursorInstance + c_CellsPerBudgetCheck, NumInstances);
+
+		for (int32 InstanceIndex = CursorInstance; InstanceIndex < EndInstance; InstanceIndex++)
+		{
+			if (ResolvedInstances[InstanceIndex] != nullptr &&
+				UpdateCell(Column, InstanceIndex, ResolvedInstances[InstanceIndex]))
+			{
+				bWatchedColumnChanged |= (ColumnToWatch == INDEX_NONE || ColumnToWatch == CursorColumn);
+			}
+		}
+
+		NumCellsLeft -= EndInstance - CursorInstance;
+		CursorInstance = EndInstance;
+
+		if (CursorInstance >= NumInstances)
+		{
+			CursorInstance = 0;
+			CursorColumn = (CursorColumn + 1) % Columns.Num();
+		}
+
+		if (BudgetInSeconds > 0.0 && FPlatformTime::Seconds() >= BudgetEndTime)
+		{
+			break;
+		}
+	}
+
+	return bWatchedColumnChanged;
+}
+
+int32 FLiveBlueprintInstanceTable::NumInstances() const
+{
+	return Instances.Num();
+}
+
+int32 FLiveBlueprintInstanceTable::NumColumns() const
+{
+	return Columns.Num();
+}
+
+AActor* FLiveBlueprintInstanceTable::GetInstance(int32 InstanceIndex) const
+{
+	return Instances[InstanceIndex].Get();
+}
+
+const FString& FLiveBlueprintInstanceTable::GetInstanceName(int32 InstanceIndex) const
+{
+	return InstanceNames[InstanceIndex];
+}
+
+const FText& FLiveBlueprintInstanceTable::GetColumnName(int32 ColumnIndex) const
+{
+	return Columns[ColumnIndex].DisplayName;
+}
+
+const FString& FLiveBlueprintInstanceTable::GetCellText(int32 InstanceIndex, int32 ColumnIndex) const
+{
+	return Columns[ColumnIndex].ValueTexts[InstanceIndex];
+}
+
+bool FLiveBlueprintInstanceTable::IsLess(int32 InstanceIndexA, int32 InstanceIndexB, int32 ColumnIndex) const
+{
+	if (ColumnIndex == INDEX_NONE)
+	{
+		return InstanceNames[InstanceIndexA] < InstanceNames[InstanceIndexB];
+	}
+
+	const FColumn& Column = Columns[ColumnIndex];
+
+	if (Column.bIsNumeric)
+	{
+		return Column.NumericValues[InstanceIndexA] < Column.NumericValues[InstanceIndexB];
+	}
+
+	return Column.ValueTexts[InstanceIndexA] < Column.ValueTexts[InstanceIndexB];
+}
+
+bool FLiveBlueprintInstanceTable::MatchesFilter(int32 InstanceIndex, int32 ColumnIndex, const FString& FilterText) const
+{
+	if (ColumnIndex != INDEX_NONE)
+	{
+		return Columns[ColumnIndex].ValueTexts[InstanceIndex].Contains(FilterText);
+	}
+
+	if (InstanceNames[InstanceIndex].Contains(FilterText))
+	{
+		return true;
+	}
+
+	for (const FColumn& Column : Columns)
+	{
+		if (Column.ValueTexts[InstanceIndex].Contains(FilterText))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FLiveBlueprintInstanceTable::AddInstance(AActor* Instance)
+{
+	Instances.Add(Instance);
+	InstanceNames.Add(Instance->GetActorLabel());
+	KnownInstances.Add(Instance);
+
+	// New cells are formatted by the next tick that reaches them, regardless of their hash.
+	for (FColumn& Column : Columns)
+	{
+		Column.ValueHashes.Add(0);
+		Column.ValueTexts.AddDefaulted();
+		Column.NumericValues.Add(0.0);
+		Column.IsCellStale.Add(true);
+	}
+}
+
+void FLiveBlueprintInstanceTable::RemoveInstanceAtSwap(int32 InstanceIndex)
+{
+	KnownInstances.Remove(Instances[InstanceIndex]);
+	Instances.RemoveAtSwap(InstanceIndex);
+	InstanceNames.RemoveAtSwap(InstanceIndex);
+
+	for (FColumn& Column : Columns)
+	{
+		Column.ValueHashes.RemoveAtSwap(InstanceIndex);
+		Column.ValueTexts.RemoveAtSwap(InstanceIndex);
+		Column.NumericValues.RemoveAtSwap(InstanceIndex);
+		Column.IsCellStale.RemoveAtSwap(InstanceIndex);
+	}
+
+	if (CursorInstance >= Instances.Num())
+	{
+		CursorInstance = 0;
+	}
+}
+
+bool FLiveBlueprintInstanceTable::UpdateCell(FColumn& Column, int32 InstanceIndex, UObject* Instance)
+{
+	void* ValuePointer = reinterpret_cast<uint8*>(Instance) + Column.Offset;
+	const uint32 ValueHash = Column.Accessor.Hash(Column.Property, ValuePointer);
+
+	if (ValueHash == Column.ValueHashes[InstanceIndex] && !Column.IsCellStale[InstanceIndex])
+	{
+		return false;
+	}
+
+	Column.ValueHashes[InstanceIndex] = ValueHash;
+	Column.IsCellStale[InstanceIndex] = false;
+	Column.ValueTexts[InstanceIndex] = FormatValue(Column, ValuePointer);
+
+	if (Column.bIsNumeric)
+	{
+		Column.NumericValues[InstanceIndex] = Column.Accessor.ReadNumber(Column.Property, ValuePointer);
+	}
+
+	return true;
+}
+
+FString FLiveBlueprintInstanceTable::FormatValue(const FColumn& Column, void* ValuePointer)
+{
+	FFastPropertyInstanceInfo PropertyInstanceInfo{
+		ValuePointer,
+		Column.Property,
+		FFastPropertyInstanceInfo::value_pointer_marker{} };
+
+	// Object references only show the object name to keep the column narrow.
+	if (Column.ValueKind == EPropertyValueKind::Object || Column.ValueKind == EPropertyValueKind::Interface)
+	{
+		const UObject* Object = PropertyInstanceInfo.GetObject().Get();
+		return (Object != nullptr) ? Object->GetName() : FString(TEXT("None"));
+	}
+
+	return PropertyInstanceInfo.GetValue().ToString().Replace(TEXT("\n"), TEXT(" "));
+}
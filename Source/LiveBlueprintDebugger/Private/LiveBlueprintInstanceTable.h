@@ -0,0 +1,91 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "LiveBlueprintValueAccessor.h"
+#include "PropertyValueHasher.h"
+
+class FLiveBlueprintClassLayout;
+
+// FLiveBlueprintInstanceTable holds the live values of the top-level Blueprint variables of every
+// instance of one Blueprint class in a world. Instances are rows and variables are columns.
+//
+// Values are stored column-wise: each column keeps the property offset from the class layout and
+// parallel arrays of per-instance hashes, text, and sort keys. Updates walk one column at a time
+// over all instances, so the same property is hashed thousands of times in a row, and the work is
+// split across frames by a time budget. Only cells whose hash changed are reformatted.
+class FLiveBlueprintInstanceTable
+{
+public:
+	// How often the world is scanned for instances that were spawned or destroyed.
+	static constexpr double InstanceScanPeriodInSeconds = 1.0;
+
+	void Reset(UWorld* World, UClass* Class);
+
+	UWorld* GetWorld() const;
+	UClass* GetClass() const;
+	bool IsStale() const;
+
+	// Adds newly spawned instances and removes destroyed ones. Returns true if the set of instances
+	// changed, in which case instance indices may have changed too.
+	bool ScanInstances();
+
+	// Updates as many cells as fit in the budget, continuing from where the previous call stopped.
+	// Returns true if any cell of ColumnToWatch changed, or any cell at all for INDEX_NONE.
+	bool Tick(double BudgetInSeconds, int32 ColumnToWatch = INDEX_NONE);
+
+	int32 NumInstances() const;
+	int32 NumColumns() const;
+	AActor* GetInstance(int32 InstanceIndex) const;
+	const FString& GetInstanceName(int32 InstanceIndex) const;
+	const FText& GetColumnName(int32 ColumnIndex) const;
+	const FString& GetCellText(int32 InstanceIndex, int32 ColumnIndex) const;
+
+	// Numeric and bool columns compare by value, all other columns compare their text. INDEX_NONE
+	// compares the instance names.
+	bool IsLess(int32 InstanceIndexA, int32 InstanceIndexB, int32 ColumnIndex) const;
+
+	// Returns true if the text of the given column, or of the instance name or any column for 
+	// INDEX_NONE, contains FilterText.
+	bool MatchesFilter(int32 InstanceIndex, int32 ColumnIndex, const FString& FilterText) const;
+
+private:
+	struct FColumn
+	{
+		const FProperty* Property = nullptr;
+		int32 Offset = 0;
+		EPropertyValueKind ValueKind = EPropertyValueKind::Other;
+		FLiveBlueprintValueAccessor Accessor;
+		bool bIsNumeric = false;
+		FText DisplayName;
+
+		// Indexed by instance.
+		TArray<uint32> ValueHashes;
+		TArray<FString> ValueTexts;
+		TArray<double> NumericValues;
+		TBitArray<> IsCellStale;
+	};
+
+	void AddInstance(AActor* Instance);
+	void RemoveInstanceAtSwap(int32 InstanceIndex);
+	bool UpdateCell(FColumn& Column, int32 InstanceIndex, UObject* Instance);
+	static FString FormatValue(const FColumn& Column, void* ValuePointer);
+
+	TWeakObjectPtr<UWorld> World;
+	TWeakObjectPtr<UClass> Class;
+	TSharedPtr<const FLiveBlueprintClassLayout> ClassLayout;
+	TArray<FColumn> Columns;
+
+	// Indexed by instance.
+	TArray<TWeakObjectPtr<AActor>> Instances;
+	TArray<FString> InstanceNames;
+	TSet<TWeakObjectPtr<AActor>> KnownInstances;
+
+	// Instances resolved once per tick, with nullptr for destroyed instances.
+	TArray<AActor*> ResolvedInstances;
+
+	int32 CursorColumn = 0;
+	int32 CursorInstance = 0;
+};
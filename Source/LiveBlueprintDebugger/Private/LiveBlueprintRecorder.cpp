@@ -0,0 +1,486 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "LiveBlueprintRecorder.h"
+
+#include <atomic>
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "LiveBlueprintByteQueue.h"
+#include "LiveBlueprintClassLayout.h"
+#include "LiveBlueprintDebugger.h"
+#include "LiveBlueprintRecordingFormat.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+// Large enough to absorb several seconds of changes to thousands of variables if the disk stalls.
+static constexpr int32 c_QueueCapacityInBytes = 16 * 1024 * 1024;
+
+// How long the writer thread sleeps when there is nothing to write.
+static constexpr float c_WriterIdleSleepInSeconds = 0.005f;
+
+static void AppendBytes(TArray<uint8>& Buffer, const void* Data, int32 NumBytes)
+{
+	Buffer.Append(static_cast<const uint8*>(Data), NumBytes);
+}
+
+template <typename ValueType>
+static void AppendValue(TArray<uint8>& Buffer, const ValueType& Value)
+{
+	AppendBytes(Buffer, &Value, sizeof(ValueType));
+}
+
+static void AppendString(TArray<uint8>& Buffer, const FString& String)
+{
+	FTCHARToUTF8 Utf8String(*String);
+	AppendValue<int32>(Buffer, Utf8String.Length());
+	AppendBytes(Buffer, Utf8String.Get(), Utf8String.Length());
+}
+
+// Keyframes are written after at least this many bytes of records, and never take up more than
+// about a quarter of the file, so that seeking replays a bounded number of records.
+static constexpr int64 c_MinBytesBetweenKeyframes = 1024 * 1024;
+static constexpr int64 c_KeyframeSizeMultiplier = 4;
+
+// FWriter drains the queue into the recording file on the writer thread. It owns the file, which
+// is only ever touched from that thread until the thread has exited.
+//
+// The writer also keeps track of the offset of the latest Value record of every row, which it 
+// periodically writes out as a Keyframe record, and writes the Index record when it is stopped.
+// This keeps all of the bookkeeping needed for seeking off the game thread.
+class FLiveBlueprintRecorder::FWriter : public FRunnable
+{
+public:
+	FWriter(FLiveBlueprintByteQueue& InQueue, TUniquePtr<FArchive> InArchive) :
+		Queue(InQueue),
+		Archive(MoveTemp(InArchive))
+	{
+	}
+
+	virtual uint32 Run() override
+	{
+		while (!bStopRequested.load(std::memory_order_acquire))
+		{
+			if (Drain() == 0)
+			{
+				FPlatformProcess::Sleep(c_WriterIdleSleepInSeconds);
+			}
+		}
+
+		// Write whatever was enqueued before the stop request.
+		Drain();
+		WriteIndex();
+		Archive->Close();
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopRequested.store(true, std::memory_order_release);
+	}
+
+private:
+	int64 Drain()
+	{
+		// Records are only ever pushed into the queue whole, so everything that is drained at once
+		// consists of complete records.
+		Staging.Reset();
+
+		const int64 NumBytes = Queue.Drain(
+			[this](const uint8* Data, uint32 NumSpanBytes)
+			{
+				Staging.Append(Data, NumSpanBytes);
+			});
+
+		if (NumBytes == 0)
+		{
+			return 0;
+		}
+
+		const uint64 StagingOffset = static_cast<uint64>(Archive->Tell());
+
+		for (int32 Position = 0; Position < Staging.Num();)
+		{
+			const uint8 RecordType = Staging[Position];
+			uint32 RecordSize = 0;
+			FMemory::Memcpy(&RecordSize, &Staging[Position + sizeof(uint8)], sizeof(uint32));
+
+			const uint64 RecordOffset = StagingOffset + Position;
+			const uint8* RecordData = &Staging[Position + LiveBlueprintRecordingFormat::RecordHeaderSize];
+
+			if (RecordType == static_cast<uint8>(ELiveBlueprintRecordType::Value))
+			{
+				uint32 InstanceId = 0;
+				int32 RowIndex = 0;
+				FMemory::Memcpy(&LatestTimeInSeconds, RecordData, sizeof(double));
+				FMemory::Memcpy(&InstanceId, RecordData + sizeof(double), sizeof(uint32));
+				FMemory::Memcpy(&RowIndex, RecordData + sizeof(double) + sizeof(uint32), sizeof(int32));
+
+				LatestValueOffsets.Add((static_cast<uint64>(InstanceId) << 32) | static_cast<uint32>(RowIndex), RecordOffset);
+			}
+			else
+			{
+				DefinitionOffsets.Add(RecordOffset);
+			}
+
+			Position += LiveBlueprintRecordingFormat::RecordHeaderSize + RecordSize;
+		}
+
+		Archive->Serialize(Staging.GetData(), Staging.Num());
+		BytesSinceKeyframe += Staging.Num();
+
+		if (BytesSinceKeyframe >= FMath::Max(c_MinBytesBetweenKeyframes, LastKeyframeSize * c_KeyframeSizeMultiplier))
+		{
+			WriteKeyframe();
+		}
+
+		return NumBytes;
+	}
+
+	void WriteKeyframe()
+	{
+		KeyframeOffsets.Add(static_cast<uint64>(Archive->Tell()));
+		KeyframeTimes.Add(LatestTimeInSeconds);
+
+		Staging.Reset();
+		AppendValue<uint8>(Staging, static_cast<uint8>(ELiveBlueprintRecordType::Keyframe));
+		AppendValue<uint32>(Staging, 0);
+		AppendValue<double>(Staging, LatestTimeInSeconds);
+		AppendValue<int32>(Staging, LatestValueOffsets.Num());
+
+		for (const TPair<uint64, uint64>& Entry : LatestValueOffsets)
+		{
+			AppendValue<uint32>(Staging, static_cast<uint32>(Entry.Key >> 32));
+			AppendValue<int32>(Staging, static_cast<int32>(Entry.Key & 0xFFFFFFFF));
+			AppendValue<uint64>(Staging, Entry.Value);
+		}
+
+		WriteStagedRecord();
+		LastKeyframeSize = Staging.Num();
+		BytesSinceKeyframe = 0;
+	}
+
+	void WriteIndex()
+	{
+		const uint64 IndexOffset = static_cast<uint64>(Archive->Tell());
+
+		Staging.Reset();
+		AppendValue<uint8>(Staging, static_cast<uint8>(ELiveBlueprintRecordType::Index));
+		AppendValue<uint32>(Staging, 0);
+		AppendValue<double>(Staging, LatestTimeInSeconds);
+		AppendValue<int32>(Staging, KeyframeOffsets.Num());
+
+		for (int32 KeyframeIndex = 0; KeyframeIndex < KeyframeOffsets.Num(); KeyframeIndex++)
+		{
+			AppendValue<double>(Staging, KeyframeTimes[KeyframeIndex]);
+			AppendValue<uint64>(Staging, KeyframeOffsets[KeyframeIndex]);
+		}
+
+		AppendValue<int32>(Staging, DefinitionOffsets.Num());
+
+		for (uint64 DefinitionOffset : DefinitionOffsets)
+		{
+			AppendValue<uint64>(Staging, DefinitionOffset);
+		}
+
+		WriteStagedRecord();
+
+		uint64 IndexOffsetToWrite = IndexOffset;
+		uint32 Magic = LiveBlueprintRecordingFormat::Magic;
+		*Archive << IndexOffsetToWrite;
+		*Archive << Magic;
+	}
+
+	void WriteStagedRecord()
+	{
+		const uint32 RecordSize = Staging.Num() - LiveBlueprintRecordingFormat::RecordHeaderSize;
+		FMemory::Memcpy(Staging.GetData() + sizeof(uint8), &RecordSize, sizeof(uint32));
+		Archive->Serialize(Staging.GetData(), Staging.Num());
+	}
+
+	FLiveBlueprintByteQueue& Queue;
+	TUniquePtr<FArchive> Archive;
+	std::atomic<bool> bStopRequested{ false };
+
+	// Reused for every drain so that writing doesn't allocate once the array has grown.
+	TArray<uint8> Staging;
+
+	// Keyed by instance id in the upper and row index in the lower 32 bits.
+	TMap<uint64, uint64> LatestValueOffsets;
+	TArray<uint64> DefinitionOffsets;
+	TArray<double> KeyframeTimes;
+	TArray<uint64> KeyframeOffsets;
+	double LatestTimeInSeconds = 0.0;
+	int64 BytesSinceKeyframe = 0;
+	int64 LastKeyframeSize = 0;
+};
+
+FLiveBlueprintRecorder& FLiveBlueprintRecorder::Get()
+{
+	static FLiveBlueprintRecorder Instance;
+	return Instance;
+}
+
+FLiveBlueprintRecorder::~FLiveBlueprintRecorder()
+{
+	Stop();
+}
+
+bool FLiveBlueprintRecorder::Start(const FString& InFilePath)
+{
+	Stop();
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(InFilePath), true);
+	TUniquePtr<FArchive> Archive{ IFileManager::Get().CreateFileWriter(*InFilePath) };
+
+	if (!Archive.IsValid())
+	{
+		UE_LOG(LogLiveBlueprintDebugger, Error, TEXT("Could not create recording file '%s'."), *InFilePath);
+		return false;
+	}
+
+	uint32 Magic = LiveBlueprintRecordingFormat::Magic;
+	uint32 Version = LiveBlueprintRecordingFormat::Version;
+	*Archive << Magic;
+	*Archive << Version;
+
+	static uint32 NextSessionId = 1;
+
+	FilePath = InFilePath;
+	SessionId = NextSessionId++;
+	StartTimeInSeconds = FPlatformTime::Seconds();
+	NumDroppedRecords = 0;
+	SchemaIds.Reset();
+	InstanceIds.Reset();
+
+	Queue = MakeUnique<FLiveBlueprintByteQueue>(c_QueueCapacityInBytes);
+	Writer = MakeUnique<FWriter>(*Queue, MoveTemp(Archive));
+	WriterThread = FRunnableThread::Create(Writer.Get(), TEXT("LiveBlueprintRecorder"), 0, TPri_BelowNormal);
+
+	UE_LOG(LogLiveBlueprintDebugger, Display, TEXT("Recording live Blueprint variables to '%s'."), *FilePath);
+	return true;
+}
+
+void FLiveBlueprintRecorder::Stop()
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	// Killing the thread with bShouldWait calls FWriter::Stop and waits for the final drain.
+	WriterThread->Kill(true);
+	delete WriterThread;
+	WriterThread = nullptr;
+	Writer.Reset();
+	Queue.Reset();
+
+	if (NumDroppedRecords > 0)
+	{
+		UE_LOG(
+			LogLiveBlueprintDebugger,
+			Warning,
+			TEXT("Dropped %lld records because the recording could not be written fast enough."),
+			NumDroppedRecords);
+	}
+
+	UE_LOG(LogLiveBlueprintDebugger, Display, TEXT("Stopped recording to '%s'."), *FilePath);
+}
+
+bool FLiveBlueprintRecorder::IsRecording() const
+{
+	return WriterThread != nullptr;
+}
+
+uint32 FLiveBlueprintRecorder::GetSessionId() const
+{
+	return IsRecording() ? SessionId : 0;
+}
+
+double FLiveBlueprintRecorder::GetTimeInSeconds() const
+{
+	return FPlatformTime::Seconds() - StartTimeInSeconds;
+}
+
+uint32 FLiveBlueprintRecorder::RegisterSchema(const FLiveBlueprintClassLayout& ClassLayout)
+{
+	const TPair<TWeakObjectPtr<UClass>, uint32> Key{ ClassLayout.GetClass(), ClassLayout.GetGeneration() };
+
+	if (const uint32* ExistingSchemaId = SchemaIds.Find(Key))
+	{
+		return *ExistingSchemaId;
+	}
+
+	const uint32 SchemaId = SchemaIds.Num() + 1;
+
+	const TArray<FLiveBlueprintPropertyLayout>& PropertyLayouts = ClassLayout.GetProperties();
+	const UClass* Class = ClassLayout.GetClass().Get();
+
+	BeginRecord(static_cast<uint8>(ELiveBlueprintRecordType::Schema));
+	AppendValue<uint32>(RecordBuffer, SchemaId);
+	AppendString(RecordBuffer, (Class != nullptr) ? Class->GetPathName() : FString());
+	AppendValue<int32>(RecordBuffer, PropertyLayouts.Num());
+
+	for (const FLiveBlueprintPropertyLayout& PropertyLayout : PropertyLayouts)
+	{
+		const EPropertyValueKind ValueKind = FPropertyValueHasher::GetValueKind(PropertyLayout.Property);
+		const bool bIsRawBytes = (ValueKind == EPropertyValueKind::PlainOldData || ValueKind == EPropertyValueKind::Bool);
+
+		AppendValue<int32>(RecordBuffer, PropertyLayout.ParentIndex);
+		AppendString(RecordBuffer, PropertyLayout.DisplayName.ToString());
+		AppendString(RecordBuffer, PropertyLayout.TypeText.ToString());
+		AppendString(RecordBuffer, FLiveBlueprintClassLayout::GetPropertyCategoryString(PropertyLayout.Property));
+		AppendValue<uint8>(RecordBuffer, static_cast<uint8>(ValueKind));
+		AppendValue<uint8>(RecordBuffer, static_cast<uint8>(
+			bIsRawBytes ? ELiveBlueprintValueEncoding::RawBytes : ELiveBlueprintValueEncoding::ExportedText));
+		AppendValue<int32>(RecordBuffer, PropertyLayout.Property->GetSize());
+	}
+
+	// The id is only handed out once the schema is in the recording, since a reader can't make
+	// sense of anything that refers to a schema it has never seen.
+	if (!EndDefinitionRecord())
+	{
+		return 0;
+	}
+
+	SchemaIds.Add(Key, SchemaId);
+	return SchemaId;
+}
+
+uint32 FLiveBlueprintRecorder::RegisterInstance(const AActor* Actor, uint32 SchemaId)
+{
+	if (const uint32* ExistingInstanceId = InstanceIds.Find(Actor))
+	{
+		return *ExistingInstanceId;
+	}
+
+	if (SchemaId == 0)
+	{
+		return 0;
+	}
+
+	const uint32 InstanceId = InstanceIds.Num() + 1;
+
+	BeginRecord(static_cast<uint8>(ELiveBlueprintRecordType::Instance));
+	AppendValue<uint32>(RecordBuffer, InstanceId);
+	AppendValue<uint32>(RecordBuffer, SchemaId);
+	AppendString(RecordBuffer, Actor->GetActorLabel());
+	AppendString(RecordBuffer, Actor->GetPathName());
+
+	if (!EndDefinitionRecord())
+	{
+		return 0;
+	}
+
+	InstanceIds.Add(Actor, InstanceId);
+	return InstanceId;
+}
+
+void FLiveBlueprintRecorder::RecordValue(
+	double TimeInSeconds,
+	uint32 InstanceId,
+	int32 RowIndex,
+	EPropertyValueKind ValueKind,
+	const FProperty* Property,
+	const void* ValuePointer)
+{
+	BeginRecord(static_cast<uint8>(ELiveBlueprintRecordType::Value));
+	AppendValue<double>(RecordBuffer, TimeInSeconds);
+	AppendValue<uint32>(RecordBuffer, InstanceId);
+	AppendValue<int32>(RecordBuffer, RowIndex);
+
+	if (ValueKind == EPropertyValueKind::PlainOldData)
+	{
+		AppendBytes(RecordBuffer, ValuePointer, Property->GetSize());
+	}
+	else if (ValueKind == EPropertyValueKind::Bool)
+	{
+		AppendValue<uint8>(RecordBuffer, CastFieldChecked<FBoolProperty>(Property)->GetPropertyValue(ValuePointer) ? 1 : 0);
+	}
+	else
+	{
+		ExportedText.Reset();
+		Property->ExportText_Direct(ExportedText, ValuePointer, ValuePointer, nullptr, PPF_None);
+
+		FTCHARToUTF8 Utf8Text(*ExportedText);
+		AppendBytes(RecordBuffer, Utf8Text.Get(), Utf8Text.Length());
+	}
+
+	EndRecord();
+}
+
+FString FLiveBlueprintRecorder::GetDefaultFilePath()
+{
+	return FPaths::Combine(
+		FPaths::ProjectSavedDir(),
+		TEXT("LiveBlueprintDebugger"),
+		FString::Printf(
+			TEXT("Session-%s.%s"),
+			*FDateTime::Now().ToString(),
+			LiveBlueprintRecordingFormat::FileExtension));
+}
+
+void FLiveBlueprintRecorder::BeginRecord(uint8 RecordType)
+{
+	RecordBuffer.Reset();
+	AppendValue<uint8>(RecordBuffer, RecordType);
+	AppendValue<uint32>(RecordBuffer, 0);
+}
+
+bool FLiveBlueprintRecorder::EndRecord()
+{
+	const uint32 RecordSize = RecordBuffer.Num() - LiveBlueprintRecordingFormat::RecordHeaderSize;
+	FMemory::Memcpy(RecordBuffer.GetData() + sizeof(uint8), &RecordSize, sizeof(uint32));
+
+	if (!Queue.IsValid() || !Queue->TryWrite(RecordBuffer.GetData(), RecordBuffer.Num()))
+	{
+		NumDroppedRecords++;
+		return false;
+	}
+
+	return true;
+}
+
+bool FLiveBlueprintRecorder::EndDefinitionRecord()
+{
+	const uint32 RecordSize = RecordBuffer.Num() - LiveBlueprintRecordingFormat::RecordHeaderSize;
+	FMemory::Memcpy(RecordBuffer.GetData() + sizeof(uint8), &RecordSize, sizeof(uint32));
+
+	// Only Value records may be dropped when the writer falls behind, since every Value record
+	// depends on the Schema and Instance records before it. Those are rare, so waiting for the
+	// writer to make room for them is cheap. A record larger than the whole queue never fits.
+	if (!Queue.IsValid() || RecordBuffer.Num() > c_QueueCapacityInBytes)
+	{
+		NumDroppedRecords++;
+		return false;
+	}
+
+	while (!Queue->TryWrite(RecordBuffer.GetData(), RecordBuffer.Num()))
+	{
+		FPlatformProcess::Sleep(c_WriterIdleSleepInSeconds);
+	}
+
+	return true;
+}
+
+static FAutoConsoleCommand StartRecordingCommand(
+	TEXT("LiveBlueprintDebugger.StartRecording"),
+	TEXT("Starts recording the live Blueprint variables of the selected actors. Optionally takes the path of the recording file."),
+	FConsoleCommandWithArgsDelegate::CreateLambda(
+		[](const TArray<FString>& Args)
+		{
+			FLiveBlueprintRecorder::Get().Start(
+				(Args.Num() > 0) ? Args[0] : FLiveBlueprintRecorder::GetDefaultFilePath());
+		}));
+
+static FAutoConsoleCommand StopRecordingCommand(
+	TEXT("LiveBlueprintDebugger.StopRecording"),
+	TEXT("Stops recording live Blueprint variables."),
+	FConsoleCommandDelegate::CreateLambda(
+		[]()
+		{
+			FLiveBlueprintRecorder::Get().Stop();
+		}));
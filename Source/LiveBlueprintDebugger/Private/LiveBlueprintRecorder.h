@@ -0,0 +1,79 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "PropertyValueHasher.h"
+
+class FLiveBlueprintByteQueue;
+class FLiveBlueprintClassLayout;
+
+// FLiveBlueprintRecorder streams the live variable values of the selected actors to a compact,
+// append-only binary file (see LiveBlueprintRecordingFormat.h), so that a whole play session can be
+// captured and inspected afterwards.
+//
+// The game thread only encodes records into a reused scratch buffer and pushes the bytes into a
+// preallocated lock-free queue. A background thread drains the queue and writes it to disk, so
+// recording never blocks on file IO. If the writer falls behind and the queue fills up, Value
+// records are dropped rather than stalling the game, and the number of dropped records is logged
+// when the recording stops. Schema and Instance records wait for room instead, since every Value
+// record after them depends on them, and their ids are only handed out once they are queued.
+//
+// Recording is started and stopped with the LiveBlueprintDebugger.StartRecording and
+// LiveBlueprintDebugger.StopRecording console commands. All other functions must be called from
+// the game thread.
+class FLiveBlueprintRecorder
+{
+public:
+	static FLiveBlueprintRecorder& Get();
+
+	~FLiveBlueprintRecorder();
+
+	bool Start(const FString& FilePath);
+	void Stop();
+	bool IsRecording() const;
+
+	// Every recording gets a new session id, so that callers can tell when they need to register
+	// their schema and instances again. Session ids are never 0.
+	uint32 GetSessionId() const;
+	double GetTimeInSeconds() const;
+
+	uint32 RegisterSchema(const FLiveBlueprintClassLayout& ClassLayout);
+	uint32 RegisterInstance(const AActor* Actor, uint32 SchemaId);
+
+	void RecordValue(
+		double TimeInSeconds,
+		uint32 InstanceId,
+		int32 RowIndex,
+		EPropertyValueKind ValueKind,
+		const FProperty* Property,
+		const void* ValuePointer);
+
+	static FString GetDefaultFilePath();
+
+private:
+	class FWriter;
+
+	FLiveBlueprintRecorder() = default;
+
+	void BeginRecord(uint8 RecordType);
+	bool EndRecord();
+	bool EndDefinitionRecord();
+
+	TUniquePtr<FLiveBlueprintByteQueue> Queue;
+	TUniquePtr<FWriter> Writer;
+	class FRunnableThread* WriterThread = nullptr;
+
+	FString FilePath;
+	uint32 SessionId = 0;
+	double StartTimeInSeconds = 0.0;
+	int64 NumDroppedRecords = 0;
+
+	TMap<TPair<TWeakObjectPtr<UClass>, uint32>, uint32> SchemaIds;
+	TMap<TWeakObjectPtr<const AActor>, uint32> InstanceIds;
+
+	// Records are encoded here before being pushed into the queue in one piece.
+	TArray<uint8> RecordBuffer;
+	FString ExportedText;
+};
@@ -0,0 +1,63 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// The layout of a Live Blueprint recording file (.lbprec).
+//
+// A recording starts with the magic number and format version, each as a little-endian uint32,
+// followed by an append-only stream of records. Every record starts with a uint8 record type and a
+// uint32 size of the rest of the record in bytes, so readers can skip records they don't know.
+//
+// Strings are stored as an int32 byte count followed by that many bytes of UTF-8. Offsets are
+// uint64 byte offsets of a record from the start of the file.
+//
+//   Schema:    uint32 SchemaId, string ClassPath, int32 NumRows, then for every row:
+//              int32 ParentIndex, string Name, string TypeText, string Category,
+//              uint8 EPropertyValueKind, uint8 ELiveBlueprintValueEncoding, int32 ValueSize
+//   Instance:  uint32 InstanceId, uint32 SchemaId, string ActorLabel, string ActorPath
+//   Value:     double TimeInSeconds, uint32 InstanceId, int32 RowIndex, then the value itself,
+//              which takes up the rest of the record
+//   Keyframe:  double TimeInSeconds, int32 NumEntries, then for every row of every instance that
+//              has been recorded so far: uint32 InstanceId, int32 RowIndex, uint64 Offset of the
+//              latest Value record
+//   Index:     double EndTimeInSeconds, int32 NumKeyframes, then for every keyframe:
+//              double TimeInSeconds, uint64 Offset, then int32 NumDefinitions, then the uint64
+//              Offset of every Schema and Instance record
+//
+// Row indices are indices into the class layout of the schema, so rows keep the same depth-first
+// order as in the details panel. Times are in seconds since the recording was started.
+//
+// Keyframes are written by the writer thread at regular intervals, so a reader can seek to any
+// time by finding the last keyframe before it and replaying a bounded number of Value records.
+// When the recording is stopped, an Index record is appended, followed by a trailer holding the
+// uint64 Offset of the Index record and the magic number. Recordings without a trailer (because
+// the editor exited unexpectedly) can still be read by scanning all records.
+namespace LiveBlueprintRecordingFormat
+{
+	static constexpr uint32 Magic = 0x5250424C; // "LBPR"
+	static constexpr uint32 Version = 2;
+	static constexpr int32 FileHeaderSize = sizeof(uint32) + sizeof(uint32);
+	static constexpr int32 RecordHeaderSize = sizeof(uint8) + sizeof(uint32);
+	static constexpr int32 TrailerSize = sizeof(uint64) + sizeof(uint32);
+	static const TCHAR* const FileExtension = TEXT("lbprec");
+}
+
+enum class ELiveBlueprintRecordType : uint8
+{
+	Schema = 1,
+	Instance = 2,
+	Value = 3,
+	Keyframe = 4,
+	Index = 5
+};
+
+enum class ELiveBlueprintValueEncoding : uint8
+{
+	// The raw bytes of the value, for plain-old-data values. Bools are stored as a single byte.
+	RawBytes = 0,
+
+	// The value exported as text, for values that own memory elsewhere.
+	ExportedText = 1
+};
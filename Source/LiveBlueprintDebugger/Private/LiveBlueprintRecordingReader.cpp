@@ -0,0 +1,509 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "LiveBlueprintRecordingReader.h"
+
+#include "Algo/BinarySearch.h"
+#include "Async/MappedFileHandle.h"
+#include "FastPropertyInstanceInfo.h"
+#include "HAL/PlatformFileManager.h"
+#include "LiveBlueprintClassLayout.h"
+
+#define LOCTEXT_NAMESPACE "FLiveBlueprintDebuggerModule"
+
+// FRecordCursor reads the fields of a record from the mapped file. Reading past the end of the
+// record marks the cursor invalid instead of reading garbage, so truncated or corrupt recordings
+// can't crash the editor.
+struct FRecordCursor
+{
+	const uint8* Data = nullptr;
+	int64 Position = 0;
+	int64 End = 0;
+	bool bIsValid = true;
+
+	template <typename ValueType>
+	ValueType Read()
+	{
+		ValueType Value{};
+
+		if (!bIsValid || Position + static_cast<int64>(sizeof(ValueType)) > End)
+		{
+			bIsValid = false;
+			return Value;
+		}
+
+		FMemory::Memcpy(&Value, Data + Position, sizeof(ValueType));
+		Position += sizeof(ValueType);
+		return Value;
+	}
+
+	FString ReadString()
+	{
+		const int32 NumBytes = Read<int32>();
+
+		if (!bIsValid || NumBytes < 0 || Position + NumBytes > End)
+		{
+			bIsValid = false;
+			return FString();
+		}
+
+		FUTF8ToTCHAR String(reinterpret_cast<const ANSICHAR*>(Data + Position), NumBytes);
+		Position += NumBytes;
+		return FString(String.Length(), String.Get());
+	}
+
+	// Returns true if the cursor holds at least NumEntries entries of EntrySize bytes.
+	bool HasEntries(int32 NumEntries, int64 EntrySize) const
+	{
+		return bIsValid && NumEntries >= 0 && Position + NumEntries * EntrySize <= End;
+	}
+};
+
+// Reads the header of the record at RecordOffset and returns a cursor over the rest of the record,
+// which is invalid if the record is cut off.
+static FRecordCursor ReadRecord(const uint8* Data, int64 Size, int64 RecordOffset, uint8& OutRecordType)
+{
+	FRecordCursor Header{ Data, RecordOffset, Size };
+	OutRecordType = Header.Read<uint8>();
+	const uint32 RecordSize = Header.Read<uint32>();
+
+	FRecordCursor Record{ Data, Header.Position, Header.Position + RecordSize };
+	Record.bIsValid = Header.bIsValid && RecordOffset >= LiveBlueprintRecordingFormat::FileHeaderSize && Record.End <= Size;
+	return Record;
+}
+
+FLiveBlueprintRecordingReader::~FLiveBlueprintRecordingReader()
+{
+	Close();
+}
+
+bool FLiveBlueprintRecordingReader::Open(const FString& InFilePath, FText& OutError)
+{
+	Close();
+
+	MappedFile = FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*InFilePath);
+
+	if (MappedFile == nullptr)
+	{
+		OutError = FText::Format(LOCTEXT("CouldNotMapRecording", "Could not open '{0}'."), FText::FromString(InFilePath));
+		return false;
+	}
+
+	MappedRegion = MappedFile->MapRegion(0, MappedFile->GetFileSize());
+
+	if (MappedRegion == nullptr)
+	{
+		Close();
+		OutError = FText::Format(LOCTEXT("CouldNotMapRecording", "Could not open '{0}'."), FText::FromString(InFilePath));
+		return false;
+	}
+
+	FilePath = InFilePath;
+	Data = MappedRegion->GetMappedPtr();
+	Size = MappedRegion->GetMappedSize();
+
+	FRecordCursor Header{ Data, 0, Size };
+	const uint32 Magic = Header.Read<uint32>();
+	const uint32 Version = Header.Read<uint32>();
+
+	if (!Header.bIsValid || Magic != LiveBlueprintRecordingFormat::Magic || Version != LiveBlueprintRecordingFormat::Version)
+	{
+		Close();
+		OutError = FText::Format(
+			LOCTEXT("NotARecording", "'{0}' is not a Live Blueprint recording, or was recorded with a different version of the plugin."),
+			FText::FromString(InFilePath));
+		return false;
+	}
+
+	// Recordings that were not stopped cleanly have no index, so they need to be scanned instead.
+	if (!ReadIndex())
+	{
+		ScanRecords();
+	}
+
+	return true;
+}
+
+void FLiveBlueprintRecordingReader::Close()
+{
+	delete MappedRegion;
+	delete MappedFile;
+	MappedRegion = nullptr;
+	MappedFile = nullptr;
+	Data = nullptr;
+	Size = 0;
+
+	FilePath.Reset();
+	DurationInSeconds = 0.0;
+	Schemas.Reset();
+	Instances.Reset();
+	SchemaIndices.Reset();
+	KeyframeTimes.Reset();
+	KeyframeOffsets.Reset();
+}
+
+bool FLiveBlueprintRecordingReader::IsOpen() const
+{
+	return Data != nullptr;
+}
+
+const FString& FLiveBlueprintRecordingReader::GetFilePath() const
+{
+	return FilePath;
+}
+
+double FLiveBlueprintRecordingReader::GetDurationInSeconds() const
+{
+	return DurationInSeconds;
+}
+
+const TArray<FLiveBlueprintRecordedSchema>& FLiveBlueprintRecordingReader::GetSchemas() const
+{
+	return Schemas;
+}
+
+const TArray<FLiveBlueprintRecordedInstance>& FLiveBlueprintRecordingReader::GetInstances() const
+{
+	return Instances;
+}
+
+void FLiveBlueprintRecordingReader::Seek(int32 InstanceIndex, double TimeInSeconds, TArray<int64>& OutValueRecordOffsets) const
+{
+	const FLiveBlueprintRecordedInstance& Instance = Instances[InstanceIndex];
+	const int32 NumRows = Schemas[Instance.SchemaIndex].Rows.Num();
+
+	OutValueRecordOffsets.Init(INDEX_NONE, NumRows);
+
+	// Start from the last keyframe at or before the requested time, if there is one.
+	const int32 KeyframeIndex = Algo::UpperBound(KeyframeTimes, TimeInSeconds) - 1;
+	int64 Position = LiveBlueprintRecordingFormat::FileHeaderSize;
+
+	if (KeyframeIndex >= 0)
+	{
+		uint8 RecordType = 0;
+		FRecordCursor Keyframe = ReadRecord(Data, Size, KeyframeOffsets[KeyframeIndex], RecordType);
+		Keyframe.Read<double>();
+		const int32 NumEntries = Keyframe.Read<int32>();
+
+		if (RecordType == static_cast<uint8>(ELiveBlueprintRecordType::Keyframe) &&
+			Keyframe.HasEntries(NumEntries, sizeof(uint32) + sizeof(int32) + sizeof(uint64)))
+		{
+			for (int32 EntryIndex = 0; EntryIndex < NumEntries; EntryIndex++)
+			{
+				const uint32 InstanceId = Keyframe.Read<uint32>();
+				const int32 RowIndex = Keyframe.Read<int32>();
+				const uint64 ValueRecordOffset = Keyframe.Read<uint64>();
+
+				if (InstanceId == Instance.InstanceId && RowIndex >= 0 && RowIndex < NumRows)
+				{
+					OutValueRecordOffsets[RowIndex] = static_cast<int64>(ValueRecordOffset);
+				}
+			}
+
+			Position = Keyframe.End;
+		}
+	}
+
+	// Replay the changes since the keyframe.
+	while (Position < Size)
+	{
+		uint8 RecordType = 0;
+		FRecordCursor Record = ReadRecord(Data, Size, Position, RecordType);
+
+		if (!Record.bIsValid || RecordType == static_cast<uint8>(ELiveBlueprintRecordType::Index))
+		{
+			break;
+		}
+
+		if (RecordType == static_cast<uint8>(ELiveBlueprintRecordType::Value))
+		{
+			const double RecordTimeInSeconds = Record.Read<double>();
+			const uint32 InstanceId = Record.Read<uint32>();
+			const int32 RowIndex = Record.Read<int32>();
+
+			if (RecordTimeInSeconds > TimeInSeconds)
+			{
+				break;
+			}
+
+			if (InstanceId == Instance.InstanceId && RowIndex >= 0 && RowIndex < NumRows)
+			{
+				OutValueRecordOffsets[RowIndex] = Position;
+			}
+		}
+
+		Position = Record.End;
+	}
+}
+
+FString FLiveBlueprintRecordingReader::GetValueText(int32 InstanceIndex, int32 RowIndex, int64 ValueRecordOffset) const
+{
+	if (ValueRecordOffset == INDEX_NONE)
+	{
+		return FString();
+	}
+
+	uint8 RecordType = 0;
+	FRecordCursor Record = ReadRecord(Data, Size, ValueRecordOffset, RecordType);
+	Record.Read<double>();
+	Record.Read<uint32>();
+	Record.Read<int32>();
+
+	if (!Record.bIsValid || RecordType != static_cast<uint8>(ELiveBlueprintRecordType::Value))
+	{
+		return FString();
+	}
+
+	const FLiveBlueprintRecordedSchema& Schema = Schemas[Instances[InstanceIndex].SchemaIndex];
+	const FLiveBlueprintRecordedRow& Row = Schema.Rows[RowIndex];
+	const uint8* ValueData = Data + Record.Position;
+	const int32 ValueSize = static_cast<int32>(Record.End - Record.Position);
+
+	if (Row.Encoding == ELiveBlueprintValueEncoding::ExportedText)
+	{
+		FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(ValueData), ValueSize);
+		return FString(Text.Length(), Text.Get()).Replace(TEXT("\n"), TEXT(" "));
+	}
+
+	if (Row.ValueKind == EPropertyValueKind::Bool)
+	{
+		return (ValueSize > 0 && ValueData[0] != 0) ? TEXT("true") : TEXT("false");
+	}
+
+	// Raw values are formatted by the property they were recorded from, as long as its class is
+	// still loaded and has not changed since.
+	if (!Schema.bTriedToResolveClassLayout || (Schema.ClassLayout.IsValid() && Schema.ClassLayout->IsStale()))
+	{
+		ResolveClassLayout(Schema);
+	}
+
+	if (Schema.ClassLayout.IsValid() && !Schema.ClassLayout->IsStale())
+	{
+		const FProperty* Property = Schema.ClassLayout->GetProperties()[RowIndex].Property;
+
+		if (Property->GetSize() == ValueSize)
+		{
+			AlignedValue.SetNumZeroed(FMath::DivideAndRoundUp<int32>(ValueSize, sizeof(uint64)));
+			FMemory::Memcpy(AlignedValue.GetData(), ValueData, ValueSize);
+
+			FFastPropertyInstanceInfo PropertyInstanceInfo{
+				AlignedValue.GetData(),
+				Property,
+				FFastPropertyInstanceInfo::value_pointer_marker{} };
+
+			return PropertyInstanceInfo.GetValue().ToString().Replace(TEXT("\n"), TEXT(" "));
+		}
+	}
+
+	return TEXT("0x") + BytesToHex(ValueData, ValueSize);
+}
+
+bool FLiveBlueprintRecordingReader::ReadIndex()
+{
+	if (Size < LiveBlueprintRecordingFormat::FileHeaderSize + LiveBlueprintRecordingFormat::TrailerSize)
+	{
+		return false;
+	}
+
+	FRecordCursor Trailer{ Data, Size - LiveBlueprintRecordingFormat::TrailerSize, Size };
+	const uint64 IndexOffset = Trailer.Read<uint64>();
+	const uint32 Magic = Trailer.Read<uint32>();
+
+	if (Magic != LiveBlueprintRecordingFormat::Magic || IndexOffset >= static_cast<uint64>(Size))
+	{
+		return false;
+	}
+
+	uint8 RecordType = 0;
+	FRecordCursor Index = ReadRecord(Data, Size, static_cast<int64>(IndexOffset), RecordType);
+
+	if (RecordType != static_cast<uint8>(ELiveBlueprintRecordType::Index))
+	{
+		return false;
+	}
+
+	DurationInSeconds = Index.Read<double>();
+	const int32 NumKeyframes = Index.Read<int32>();
+
+	if (!Index.HasEntries(NumKeyframes, sizeof(double) + sizeof(uint64)))
+	{
+		return false;
+	}
+
+	KeyframeTimes.Reserve(NumKeyframes);
+	KeyframeOffsets.Reserve(NumKeyframes);
+
+	for (int32 KeyframeIndex = 0; KeyframeIndex < NumKeyframes; KeyframeIndex++)
+	{
+		KeyframeTimes.Add(Index.Read<double>());
+		KeyframeOffsets.Add(static_cast<int64>(Index.Read<uint64>()));
+	}
+
+	const int32 NumDefinitions = Index.Read<int32>();
+
+	if (!Index.HasEntries(NumDefinitions, sizeof(uint64)))
+	{
+		KeyframeTimes.Reset();
+		KeyframeOffsets.Reset();
+		return false;
+	}
+
+	for (int32 DefinitionIndex = 0; DefinitionIndex < NumDefinitions; DefinitionIndex++)
+	{
+		ReadDefinition(static_cast<int64>(Index.Read<uint64>()));
+	}
+
+	return true;
+}
+
+void FLiveBlueprintRecordingReader::ScanRecords()
+{
+	int64 Position = LiveBlueprintRecordingFormat::FileHeaderSize;
+
+	while (Position < Size)
+	{
+		uint8 RecordType = 0;
+		FRecordCursor Record = ReadRecord(Data, Size, Position, RecordType);
+
+		// The last record may have been cut off when the editor exited.
+		if (!Record.bIsValid)
+		{
+			break;
+		}
+
+		switch (static_cast<ELiveBlueprintRecordType>(RecordType))
+		{
+			case ELiveBlueprintRecordType::Schema:
+			case ELiveBlueprintRecordType::Instance:
+			{
+				ReadDefinition(Position);
+				break;
+			}
+
+			case ELiveBlueprintRecordType::Value:
+			{
+				DurationInSeconds = FMath::Max(DurationInSeconds, Record.Read<double>());
+				break;
+			}
+
+			case ELiveBlueprintRecordType::Keyframe:
+			{
+				KeyframeTimes.Add(Record.Read<double>());
+				KeyframeOffsets.Add(Position);
+				break;
+			}
+
+			default:
+			{
+				break;
+			}
+		}
+
+		Position = Record.End;
+	}
+}
+
+bool FLiveBlueprintRecordingReader::ReadDefinition(int64 RecordOffset)
+{
+	uint8 RecordType = 0;
+	FRecordCursor Record = ReadRecord(Data, Size, RecordOffset, RecordType);
+
+	if (RecordType == static_cast<uint8>(ELiveBlueprintRecordType::Schema))
+	{
+		FLiveBlueprintRecordedSchema Schema;
+		Schema.SchemaId = Record.Read<uint32>();
+		Schema.ClassPath = Record.ReadString();
+		const int32 NumRows = Record.Read<int32>();
+
+		if (!Record.bIsValid || NumRows < 0)
+		{
+			return false;
+		}
+
+		for (int32 RowIndex = 0; RowIndex < NumRows && Record.bIsValid; RowIndex++)
+		{
+			FLiveBlueprintRecordedRow& Row = Schema.Rows.AddDefaulted_GetRef();
+			Row.ParentIndex = Record.Read<int32>();
+			Row.Name = Record.ReadString();
+			Row.TypeText = Record.ReadString();
+			Row.Category = Record.ReadString();
+			Row.ValueKind = static_cast<EPropertyValueKind>(Record.Read<uint8>());
+			Row.Encoding = static_cast<ELiveBlueprintValueEncoding>(Record.Read<uint8>());
+			Row.ValueSize = Record.Read<int32>();
+
+			// Parents always come before their children.
+			if (Row.ParentIndex >= RowIndex)
+			{
+				return false;
+			}
+
+			Row.Depth = (Row.ParentIndex != INDEX_NONE) ? Schema.Rows[Row.ParentIndex].Depth + 1 : 0;
+		}
+
+		if (!Record.bIsValid)
+		{
+			return false;
+		}
+
+		SchemaIndices.Add(Schema.SchemaId, Schemas.Num());
+		Schemas.Add(MoveTemp(Schema));
+		return true;
+	}
+	else if (RecordType == static_cast<uint8>(ELiveBlueprintRecordType::Instance))
+	{
+		FLiveBlueprintRecordedInstance Instance;
+		Instance.InstanceId = Record.Read<uint32>();
+		const uint32 SchemaId = Record.Read<uint32>();
+		Instance.ActorLabel = Record.ReadString();
+		Instance.ActorPath = Record.ReadString();
+
+		// Schemas are always written before the instances that use them.
+		const int32* SchemaIndex = SchemaIndices.Find(SchemaId);
+
+		if (!Record.bIsValid || SchemaIndex == nullptr)
+		{
+			return false;
+		}
+
+		Instance.SchemaIndex = *SchemaIndex;
+		Instances.Add(MoveTemp(Instance));
+		return true;
+	}
+
+	return false;
+}
+
+void FLiveBlueprintRecordingReader::ResolveClassLayout(const FLiveBlueprintRecordedSchema& Schema)
+{
+	Schema.bTriedToResolveClassLayout = true;
+	Schema.ClassLayout.Reset();
+
+	UClass* Class = FindObject<UClass>(nullptr, *Schema.ClassPath);
+
+	if (Class == nullptr)
+	{
+		return;
+	}
+
+	TSharedRef<const FLiveBlueprintClassLayout> ClassLayout = FLiveBlueprintClassLayoutCache::Get().FindOrBuild(Class);
+	const TArray<FLiveBlueprintPropertyLayout>& PropertyLayouts = ClassLayout->GetProperties();
+
+	if (PropertyLayouts.Num() != Schema.Rows.Num())
+	{
+		return;
+	}
+
+	for (int32 RowIndex = 0; RowIndex < PropertyLayouts.Num(); RowIndex++)
+	{
+		const FProperty* Property = PropertyLayouts[RowIndex].Property;
+
+		if (Property->GetSize() != Schema.Rows[RowIndex].ValueSize ||
+			FPropertyValueHasher::GetValueKind(Property) != Schema.Rows[RowIndex].ValueKind)
+		{
+			return;
+		}
+	}
+
+	Schema.ClassLayout = ClassLayout;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,98 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "LiveBlueprintRecordingFormat.h"
+#include "PropertyValueHasher.h"
+
+class FLiveBlueprintClassLayout;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+struct FLiveBlueprintRecordedRow
+{
+	int32 ParentIndex = INDEX_NONE;
+	int32 Depth = 0;
+	FString Name;
+	FString TypeText;
+	FString Category;
+	EPropertyValueKind ValueKind = EPropertyValueKind::Other;
+	ELiveBlueprintValueEncoding Encoding = ELiveBlueprintValueEncoding::ExportedText;
+	int32 ValueSize = 0;
+};
+
+struct FLiveBlueprintRecordedSchema
+{
+	uint32 SchemaId = 0;
+	FString ClassPath;
+	TArray<FLiveBlueprintRecordedRow> Rows;
+
+	// The layout of the class if it is loaded and still matches the recorded rows, which is used to
+	// format raw values the same way as the details panel. Resolved on first use.
+	mutable TSharedPtr<const FLiveBlueprintClassLayout> ClassLayout;
+	mutable bool bTriedToResolveClassLayout = false;
+};
+
+struct FLiveBlueprintRecordedInstance
+{
+	uint32 InstanceId = 0;
+	int32 SchemaIndex = INDEX_NONE;
+	FString ActorLabel;
+	FString ActorPath;
+};
+
+// FLiveBlueprintRecordingReader reads a recording written by FLiveBlueprintRecorder (see
+// LiveBlueprintRecordingFormat.h) through a memory mapping, so that even very large recordings
+// are never loaded into memory as a whole.
+//
+// Opening a finished recording only reads its Index record and the Schema and Instance records it
+// points to. Seeking binary searches the keyframe times, reads the keyframe before the requested
+// time, and then replays the Value records written after that keyframe up to the requested time,
+// which the recorder keeps to a bounded number of bytes.
+class FLiveBlueprintRecordingReader
+{
+public:
+	~FLiveBlueprintRecordingReader();
+
+	bool Open(const FString& FilePath, FText& OutError);
+	void Close();
+	bool IsOpen() const;
+
+	const FString& GetFilePath() const;
+	double GetDurationInSeconds() const;
+	const TArray<FLiveBlueprintRecordedSchema>& GetSchemas() const;
+	const TArray<FLiveBlueprintRecordedInstance>& GetInstances() const;
+
+	// Finds the Value record holding the value of every row of the instance at the given time.
+	// OutValueRecordOffsets gets one entry per row of the instance's schema, which is INDEX_NONE if
+	// the row had not been recorded yet.
+	void Seek(int32 InstanceIndex, double TimeInSeconds, TArray<int64>& OutValueRecordOffsets) const;
+
+	FString GetValueText(int32 InstanceIndex, int32 RowIndex, int64 ValueRecordOffset) const;
+
+private:
+	bool ReadIndex();
+	void ScanRecords();
+	bool ReadDefinition(int64 RecordOffset);
+	static void ResolveClassLayout(const FLiveBlueprintRecordedSchema& Schema);
+
+	FString FilePath;
+	IMappedFileHandle* MappedFile = nullptr;
+	IMappedFileRegion* MappedRegion = nullptr;
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+
+	double DurationInSeconds = 0.0;
+	TArray<FLiveBlueprintRecordedSchema> Schemas;
+	TArray<FLiveBlueprintRecordedInstance> Instances;
+	TMap<uint32, int32> SchemaIndices;
+
+	// Sorted by time, since keyframes are written in order.
+	TArray<double> KeyframeTimes;
+	TArray<int64> KeyframeOffsets;
+
+	// Scratch space for formatting raw values, aligned for any property type.
+	mutable TArray<uint64> AlignedValue;
+};
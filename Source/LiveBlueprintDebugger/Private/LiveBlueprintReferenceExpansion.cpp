@@ -0,0 +1,246 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "LiveBlueprintReferenceExpansion.h"
+
+#include "LiveBlueprintClassLayout.h"
+#include "UObject/ScriptInterface.h"
+
+UObject* FLiveBlueprintReferenceExpansion::GetReferencedObject(const FProperty* Property, const void* ValuePointer)
+{
+	if (auto ObjectProperty = CastField<FObjectPropertyBase>(Property); ObjectProperty != nullptr)
+	{
+		return ObjectProperty->GetObjectPropertyValue(ValuePointer);
+	}
+	else if (Property->IsA<FInterfaceProperty>())
+	{
+		return static_cast<const FScriptInterface*>(ValuePointer)->GetObject();
+	}
+
+	return nullptr;
+}
+
+void FLiveBlueprintReferenceExpansion::ExpandRoot(UObject* Object)
+{
+	Reset();
+
+	if (Object == nullptr)
+	{
+		return;
+	}
+
+	RootObject = FObjectKey(Object);
+	ExpandedObjects.Add(RootObject);
+	AddMembers(0, Object, 0, 0);
+}
+
+bool FLiveBlueprintReferenceExpansion::Expand(int32 NodeIndex)
+{
+	FNode& Node = Nodes[NodeIndex];
+
+	// A note node is replaced by the next batch of members, which ends in a new note if there are
+	// still more.
+	if (Node.bIsNote)
+	{
+		UObject* Object = Node.Object.Get();
+
+		if (Object == nullptr)
+		{
+			return false;
+		}
+
+		const int32 FirstPropertyIndex = Node.PropertyIndex;
+		const int32 Depth = Node.Depth;
+		Nodes.RemoveAt(NodeIndex);
+		AddMembers(NodeIndex, Object, FirstPropertyIndex, Depth);
+		return true;
+	}
+
+	UObject* ReferencedObject = GetReferencedObject(NodeIndex);
+
+	if (Node.bIsExpanded || ReferencedObject == nullptr || ExpandedObjects.Contains(FObjectKey(ReferencedObject)))
+	{
+		return false;
+	}
+
+	Node.bIsExpanded = true;
+	Node.ExpandedObject = FObjectKey(ReferencedObject);
+	ExpandedObjects.Add(Node.ExpandedObject);
+	AddMembers(NodeIndex + 1, ReferencedObject, 0, Node.Depth + 1);
+	return true;
+}
+
+void FLiveBlueprintReferenceExpansion::Collapse(int32 NodeIndex)
+{
+	FNode& Node = Nodes[NodeIndex];
+
+	if (!Node.bIsExpanded)
+	{
+		return;
+	}
+
+	int32 EndIndex = NodeIndex + 1;
+
+	while (EndIndex < Nodes.Num() && Nodes[EndIndex].Depth > Node.Depth)
+	{
+		if (Nodes[EndIndex].bIsExpanded)
+		{
+			ExpandedObjects.Remove(Nodes[EndIndex].ExpandedObject);
+		}
+
+		EndIndex++;
+	}
+
+	ExpandedObjects.Remove(Node.ExpandedObject);
+	Node.bIsExpanded = false;
+	Node.ExpandedObject = FObjectKey();
+	Nodes.RemoveAt(NodeIndex + 1, EndIndex - NodeIndex - 1);
+}
+
+void FLiveBlueprintReferenceExpansion::Reset()
+{
+	Nodes.Reset();
+	RootObject = FObjectKey();
+	ExpandedObjects.Reset();
+}
+
+int32 FLiveBlueprintReferenceExpansion::Num() const
+{
+	return Nodes.Num();
+}
+
+bool FLiveBlueprintReferenceExpansion::IsEmpty() const
+{
+	return Nodes.Num() == 0;
+}
+
+const FLiveBlueprintReferenceExpansion::FNode& FLiveBlueprintReferenceExpansion::GetNode(int32 NodeIndex) const
+{
+	return Nodes[NodeIndex];
+}
+
+FLiveBlueprintReferenceExpansion::FNode& FLiveBlueprintReferenceExpansion::GetNode(int32 NodeIndex)
+{
+	return Nodes[NodeIndex];
+}
+
+bool FLiveBlueprintReferenceExpansion::IsStale() const
+{
+	return Nodes.ContainsByPredicate(
+		[](const FNode& Node)
+		{
+			return Node.ClassLayout->IsStale();
+		});
+}
+
+const FProperty* FLiveBlueprintReferenceExpansion::GetProperty(int32 NodeIndex) const
+{
+	const FNode& Node = Nodes[NodeIndex];
+
+	if (Node.bIsNote)
+	{
+		return nullptr;
+	}
+
+	return Node.ClassLayout->GetProperties()[Node.PropertyIndex].Property;
+}
+
+void* FLiveBlueprintReferenceExpansion::GetValuePointer(int32 NodeIndex) const
+{
+	const FNode& Node = Nodes[NodeIndex];
+	UObject* Object = Node.Object.Get();
+
+	if (Node.bIsNote || Object == nullptr)
+	{
+		return nullptr;
+	}
+
+	return reinterpret_cast<uint8*>(Object) + Node.ClassLayout->GetProperties()[Node.PropertyIndex].Offset;
+}
+
+bool FLiveBlueprintReferenceExpansion::IsReference(int32 NodeIndex) const
+{
+	const FNode& Node = Nodes[NodeIndex];
+
+	if (Node.bIsNote)
+	{
+		return false;
+	}
+
+	const EPropertyValueKind ValueKind = Node.ClassLayout->GetProperties()[Node.PropertyIndex].ValueKind;
+	return ValueKind == EPropertyValueKind::Object || ValueKind == EPropertyValueKind::Interface;
+}
+
+bool FLiveBlueprintReferenceExpansion::IsExpandedElsewhere(int32 NodeIndex) const
+{
+	if (Nodes[NodeIndex].bIsExpanded)
+	{
+		return false;
+	}
+
+	UObject* ReferencedObject = GetReferencedObject(NodeIndex);
+	return ReferencedObject != nullptr && ExpandedObjects.Contains(FObjectKey(ReferencedObject));
+}
+
+void FLiveBlueprintReferenceExpansion::AddMembers(int32 InsertIndex, UObject* Object, int32 FirstPropertyIndex, int32 Depth)
+{
+	// The layout of any class only lists its Blueprint-visible properties, which is exactly what the
+	// Blueprint Debugger shows for a reference. Members of struct members are not listed separately,
+	// since the struct's value text already shows them.
+	TSharedRef<const FLiveBlueprintClassLayout> ClassLayout = FLiveBlueprintClassLayoutCache::Get().FindOrBuild(Object->GetClass());
+	const TArray<FLiveBlueprintPropertyLayout>& PropertyLayouts = ClassLayout->GetProperties();
+
+	TArray<FNode> NewNodes;
+	int32 PropertyIndex = FirstPropertyIndex;
+
+	for (; PropertyIndex < PropertyLayouts.Num() && NewNodes.Num() < MaxNodesPerExpansion; PropertyIndex++)
+	{
+		if (PropertyLayouts[PropertyIndex].ParentIndex != INDEX_NONE)
+		{
+			continue;
+		}
+
+		// New members start out with their current value, so that they aren't shown as changed.
+		const FLiveBlueprintPropertyLayout& PropertyLayout = PropertyLayouts[PropertyIndex];
+
+		FNode& Node = NewNodes.AddDefaulted_GetRef();
+		Node.Object = Object;
+		Node.ClassLayout = ClassLayout;
+		Node.PropertyIndex = PropertyIndex;
+		Node.Depth = Depth;
+		Node.ValueHash = PropertyLayout.Accessor.Hash(
+			PropertyLayout.Property, 
+			reinterpret_cast<uint8*>(Object) + PropertyLayout.Offset);
+	}
+
+	int32 NumHiddenMembers = 0;
+
+	for (int32 HiddenIndex = PropertyIndex; HiddenIndex < PropertyLayouts.Num(); HiddenIndex++)
+	{
+		NumHiddenMembers += (PropertyLayouts[HiddenIndex].ParentIndex == INDEX_NONE) ? 1 : 0;
+	}
+
+	if (NumHiddenMembers > 0)
+	{
+		FNode& Note = NewNodes.AddDefaulted_GetRef();
+		Note.Object = Object;
+		Note.ClassLayout = ClassLayout;
+		Note.PropertyIndex = PropertyIndex;
+		Note.NumHiddenMembers = NumHiddenMembers;
+		Note.bIsNote = true;
+		Note.Depth = Depth;
+	}
+
+	Nodes.Insert(NewNodes, InsertIndex);
+}
+
+UObject* FLiveBlueprintReferenceExpansion::GetReferencedObject(int32 NodeIndex) const
+{
+	const void* ValuePointer = GetValuePointer(NodeIndex);
+
+	if (ValuePointer == nullptr || !IsReference(NodeIndex))
+	{
+		return nullptr;
+	}
+
+	return GetReferencedObject(GetProperty(NodeIndex), ValuePointer);
+}
@@ -0,0 +1,91 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class FLiveBlueprintClassLayout;
+
+// FLiveBlueprintReferenceExpansion holds the members of the object that an object or interface
+// cell refers to, expanded on demand when the user clicks the reference.
+//
+// Following every reference up front is what made FPropertyInstanceInfo take hundreds of
+// milliseconds, so nothing is expanded until it is asked for, and each click only expands one level:
+// the Blueprint-visible variables of the referenced object, taken from the class layout of its
+// class. Members that are references themselves can be expanded in turn. An object that is already
+// expanded somewhere in the expansion is not expanded again, which stops reference cycles.
+//
+// Each expansion adds at most MaxNodesPerExpansion members. The rest are summarized by a note node,
+// which shows the next batch when it is clicked, so expanding a native object with hundreds of
+// properties stays cheap.
+//
+// Nodes are kept in depth-first order, which is the order they are shown in, so the descendants of a
+// node always directly follow it.
+class FLiveBlueprintReferenceExpansion
+{
+public:
+	static constexpr int32 MaxNodesPerExpansion = 32;
+
+	struct FNode
+	{
+		// The object that the member belongs to, and the layout of its class.
+		TWeakObjectPtr<UObject> Object;
+		TSharedPtr<const FLiveBlueprintClassLayout> ClassLayout;
+
+		// Index into the properties of ClassLayout. For note nodes, this is the first member that is
+		// not shown yet.
+		int32 PropertyIndex = INDEX_NONE;
+		int32 NumHiddenMembers = 0;
+		bool bIsNote = false;
+
+		int32 Depth = 0;
+		uint32 ValueHash = 0;
+		double LastUpdateTime = 0.0;
+		bool bIsExpanded = false;
+
+		// The object whose members were expanded below the node, which the reference may no longer
+		// point to by the time the node is collapsed.
+		FObjectKey ExpandedObject;
+	};
+
+	static UObject* GetReferencedObject(const FProperty* Property, const void* ValuePointer);
+
+	// Expands the members of Object at the top of the expansion.
+	void ExpandRoot(UObject* Object);
+
+	// Expands the members of the object that a reference node refers to, or the next batch of
+	// members for a note node. Returns false if there was nothing to expand.
+	bool Expand(int32 NodeIndex);
+	void Collapse(int32 NodeIndex);
+	void Reset();
+
+	int32 Num() const;
+	bool IsEmpty() const;
+	const FNode& GetNode(int32 NodeIndex) const;
+	FNode& GetNode(int32 NodeIndex);
+
+	// Any node whose class was recompiled can't be read anymore.
+	bool IsStale() const;
+
+	// Returns nullptr for note nodes and for members of objects that were destroyed.
+	const FProperty* GetProperty(int32 NodeIndex) const;
+	void* GetValuePointer(int32 NodeIndex) const;
+
+	bool IsReference(int32 NodeIndex) const;
+
+	// The object that a reference node currently refers to.
+	UObject* GetReferencedObject(int32 NodeIndex) const;
+
+	// True for references to objects that are already expanded by another node.
+	bool IsExpandedElsewhere(int32 NodeIndex) const;
+
+private:
+	void AddMembers(int32 InsertIndex, UObject* Object, int32 FirstPropertyIndex, int32 Depth);
+
+	TArray<FNode> Nodes;
+	FObjectKey RootObject;
+
+	// Every object that is currently expanded, including the root.
+	TSet<FObjectKey> ExpandedObjects;
+};
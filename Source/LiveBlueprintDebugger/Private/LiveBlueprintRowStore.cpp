@@ -0,0 +1,129 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "LiveBlueprintRowStore.h"
+
+#include "LiveBlueprintClassLayout.h"
+#include "LiveBlueprintDebuggerStats.h"
+#include "LiveBlueprintValueHistory.h"
+#include "SLiveBlueprintValueWidget.h"
+
+void FLiveBlueprintRowStore::Initialize(
+	const FLiveBlueprintClassLayout& ClassLayout, 
+	int32 InNumInstances, 
+	bool bRecordHistory)
+{
+	const TArray<FLiveBlueprintPropertyLayout>& PropertyLayouts = ClassLayout.GetProperties();
+	const int32 NumRows = PropertyLayouts.Num();
+	const int32 NumCells = NumRows * InNumInstances;
+
+	InstanceCount = InNumInstances;
+
+	Arena.Reset();
+	Arena.Reserve(
+		FLiveBlueprintArena::GetArraySize<const FProperty*>(NumRows) +
+		FLiveBlueprintArena::GetArraySize<int32>(NumRows) * 2 +
+		FLiveBlueprintArena::GetArraySize<EPropertyValueKind>(NumRows) +
+		FLiveBlueprintArena::GetArraySize<FLiveBlueprintValueAccessor>(NumRows) +
+		FLiveBlueprintArena::GetArraySize<bool>(NumRows) +
+		FLiveBlueprintArena::GetArraySize<uint32>(NumCells) +
+		FLiveBlueprintArena::GetArraySize<double>(NumCells) +
+		FLiveBlueprintArena::GetArraySize<int32>(NumCells) * 2);
+
+	Properties = Arena.AllocateArray<const FProperty*>(NumRows, nullptr);
+	ParentIndices = Arena.AllocateArray<int32>(NumRows, INDEX_NONE);
+	ValueOffsets = Arena.AllocateArray<int32>(NumRows, 0);
+	ValueKinds = Arena.AllocateArray<EPropertyValueKind>(NumRows, EPropertyValueKind::Other);
+	Accessors = Arena.AllocateArray<FLiveBlueprintValueAccessor>(NumRows, FLiveBlueprintValueAccessor{});
+	IsGroupRow = Arena.AllocateArray<bool>(NumRows, false);
+
+	for (int32 RowIndex = 0; RowIndex < NumRows; RowIndex++)
+	{
+		const FLiveBlueprintPropertyLayout& PropertyLayout = PropertyLayouts[RowIndex];
+
+		Properties[RowIndex] = PropertyLayout.Property;
+		ParentIndices[RowIndex] = PropertyLayout.ParentIndex;
+		ValueOffsets[RowIndex] = PropertyLayout.Offset;
+		ValueKinds[RowIndex] = PropertyLayout.ValueKind;
+		Accessors[RowIndex] = PropertyLayout.Accessor;
+		IsGroupRow[RowIndex] = PropertyLayout.bIsGroup;
+	}
+
+	ValueHashes = Arena.AllocateArray<uint32>(NumCells, 0);
+	LastUpdateTimes = Arena.AllocateArray<double>(NumCells, 0.0);
+	ValueWidgets.Reset();
+	ValueWidgets.SetNum(NumCells);
+
+	ContainerStateIndices = Arena.AllocateArray<int32>(NumCells, INDEX_NONE);
+	ContainerStates.Reset();
+	HistorySlotIndices = Arena.AllocateArray<int32>(NumCells, INDEX_NONE);
+	NumHistorySlots = 0;
+
+	for (int32 RowIndex = 0; RowIndex < NumRows; RowIndex++)
+	{
+		const bool bIsContainerRow = IsContainerRow(RowIndex);
+		const bool bHasHistory = bRecordHistory && FLiveBlueprintValueHistory::IsNumericProperty(Properties[RowIndex]);
+
+		for (int32 InstanceIndex = 0; InstanceIndex < InstanceCount; InstanceIndex++)
+		{
+			const int32 CellIndex = GetCellIndex(RowIndex, InstanceIndex);
+
+			ContainerStateIndices[CellIndex] = bIsContainerRow ? ContainerStates.AddDefaulted() : INDEX_NONE;
+			HistorySlotIndices[CellIndex] = bHasHistory ? NumHistorySlots++ : INDEX_NONE;
+		}
+	}
+}
+
+int32 FLiveBlueprintRowStore::Num() const
+{
+	return Properties.Num();
+}
+
+int32 FLiveBlueprintRowStore::NumInstances() const
+{
+	return InstanceCount;
+}
+
+int32 FLiveBlueprintRowStore::GetCellIndex(int32 RowIndex, int32 InstanceIndex) const
+{
+	return RowIndex * InstanceCount + InstanceIndex;
+}
+
+void* FLiveBlueprintRowStore::GetValuePointer(int32 RowIndex, UObject* Object) const
+{
+	return reinterpret_cast<uint8*>(Object) + ValueOffsets[RowIndex];
+}
+
+uint32 FLiveBlueprintRowStore::HashValue(int32 RowIndex, UObject* Object) const
+{
+	return Accessors[RowIndex].Hash(Properties[RowIndex], GetValuePointer(RowIndex, Object));
+}
+
+bool FLiveBlueprintRowStore::IsContainerRow(int32 RowIndex) const
+{
+	const EPropertyValueKind ValueKind = ValueKinds[RowIndex];
+
+	return (
+		ValueKind == EPropertyValueKind::Array ||
+		ValueKind == EPropertyValueKind::Map ||
+		ValueKind == EPropertyValueKind::Set);
+}
+
+SIZE_T FLiveBlueprintRowStore::GetAllocatedSize() const
+{
+	SIZE_T AllocatedSize =
+		Arena.GetAllocatedSize() +
+		ValueWidgets.GetAllocatedSize() +
+		ContainerStates.GetAllocatedSize();
+
+	for (const FLiveBlueprintContainerState& ContainerState : ContainerStates)
+	{
+		AllocatedSize +=
+			ContainerState.ElementHashes.GetAllocatedSize() +
+			ContainerState.ElementUpdateTimes.GetAllocatedSize() +
+			ContainerState.ElementKeyHashes.GetAllocatedSize() +
+			ContainerState.KeyedElementHashes.GetAllocatedSize() +
+			ContainerState.PreviousKeyedElementHashes.GetAllocatedSize();
+	}
+
+	return AllocatedSize;
+}
@@ -0,0 +1,91 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "LiveBlueprintArena.h"
+#include "LiveBlueprintValueAccessor.h"
+#include "PropertyValueHasher.h"
+
+class FLiveBlueprintClassLayout;
+
+// Per-element state of a set, array, or map row, used to find which elements changed between
+// updates so that only those elements are reformatted and highlighted. Arrays are diffed by
+// position, and only the page of elements that is currently displayed is tracked for them.
+//
+// Sets and maps are diffed by key instead, since removing one key moves every later element to a
+// new position. Their keys are tracked for the whole container, so that a key that was added or
+// removed is noticed even when the number of elements stays the same.
+struct FLiveBlueprintContainerState
+{
+	int32 TotalNumElements = 0;
+	int32 FirstVisibleElement = 0;
+
+	// Indexed relative to FirstVisibleElement.
+	TArray<uint32> ElementHashes;
+	TArray<double> ElementUpdateTimes;
+
+	// Sets and maps only. The hash of the key of each displayed element, indexed like ElementHashes,
+	// and the hash of every element's value keyed by the hash of its key. The key of a set element
+	// is the element itself. The table is rebuilt into the previous one when the hash of the whole
+	// container changes, so that neither is reallocated.
+	TArray<uint32> ElementKeyHashes;
+	TMap<uint32, uint32> KeyedElementHashes;
+	TMap<uint32, uint32> PreviousKeyedElementHashes;
+	uint32 KeyedValueHash = 0;
+	bool bHasKeyedElementHashes = false;
+};
+
+// FLiveBlueprintRowStore holds the state of every row shown in the details panel for a selection
+// of actors that share the same class. There is exactly one row per entry in the class layout 
+// (struct groups get a header row), in the same depth-first order, so a child row always comes 
+// after its parent.
+//
+// Each row has one cell per selected actor ("instance") holding that actor's value state. Cells are
+// stored row-major, so all instances of a row are next to each other and are updated in one pass.
+//
+// Rows are stored as parallel arrays rather than as a tree of FFastPropertyInstanceInfo objects so
+// that the per-tick update is a linear scan over small, contiguous arrays. Value text is only
+// generated on demand when a row's value has changed. The arrays of plain values are all carved
+// out of one arena allocation that is released in one go with the store.
+struct FLiveBlueprintRowStore
+{
+	void Initialize(const FLiveBlueprintClassLayout& ClassLayout, int32 NumInstances, bool bRecordHistory);
+
+	int32 Num() const;
+	int32 NumInstances() const;
+	int32 GetCellIndex(int32 RowIndex, int32 InstanceIndex) const;
+	void* GetValuePointer(int32 RowIndex, UObject* Object) const;
+	uint32 HashValue(int32 RowIndex, UObject* Object) const;
+	bool IsContainerRow(int32 RowIndex) const;
+
+	// The memory held by the store itself, not counting the value widgets it points to.
+	SIZE_T GetAllocatedSize() const;
+
+	// Indexed by row.
+	TArrayView<const FProperty*> Properties;
+	TArrayView<int32> ParentIndices;
+	TArrayView<int32> ValueOffsets;
+	TArrayView<EPropertyValueKind> ValueKinds;
+	TArrayView<FLiveBlueprintValueAccessor> Accessors;
+	TArrayView<bool> IsGroupRow;
+
+	// Indexed by cell.
+	TArrayView<uint32> ValueHashes;
+	TArrayView<double> LastUpdateTimes;
+	TArray<TSharedPtr<class SLiveBlueprintValueWidget>> ValueWidgets;
+
+	// Index into ContainerStates for cells of set, array, and map rows, or INDEX_NONE for other rows.
+	TArrayView<int32> ContainerStateIndices;
+	TArray<FLiveBlueprintContainerState> ContainerStates;
+
+	// Index of the FLiveBlueprintValueHistory slot for cells of numeric, enum, and bool rows when
+	// history is recorded, or INDEX_NONE for other rows.
+	TArrayView<int32> HistorySlotIndices;
+	int32 NumHistorySlots = 0;
+
+private:
+	FLiveBlueprintArena Arena;
+	int32 InstanceCount = 1;
+};
@@ -0,0 +1,112 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "LiveBlueprintSelectionState.h"
+
+#include "GameFramework/Actor.h"
+#include "LiveBlueprintClassLayout.h"
+#include "LiveBlueprintDebuggerStats.h"
+
+FLiveBlueprintSelectionState::~FLiveBlueprintSelectionState()
+{
+	DEC_MEMORY_STAT_BY(STAT_LiveBlueprint_RowMemory, ReportedMemorySize);
+	TRACE_COUNTER_SUBTRACT(LiveBlueprint_RowMemory, ReportedMemorySize);
+}
+
+bool FLiveBlueprintSelectionState::IsFor(
+	const TArray<TWeakObjectPtr<AActor>>& InActors,
+	const FLiveBlueprintClassLayout& InClassLayout) const
+{
+	return (
+		ClassLayout->GetClass() == InClassLayout.GetClass() &&
+		ClassLayout->GetGeneration() == InClassLayout.GetGeneration() &&
+		Actors == InActors);
+}
+
+SIZE_T FLiveBlueprintSelectionState::GetAllocatedSize() const
+{
+	return (
+		Rows.GetAllocatedSize() +
+		ValueHistory->GetAllocatedSize() +
+		SnapshotDiffer.GetAllocatedSize() +
+		ValueTexts.GetAllocatedSize());
+}
+
+TSharedRef<FLiveBlueprintSelectionState> FLiveBlueprintSelectionStateCache::Acquire(
+	const TArray<TWeakObjectPtr<AActor>>& Actors,
+	const TSharedRef<const FLiveBlueprintClassLayout>& ClassLayout,
+	bool bCanBeCached)
+{
+	RemoveUnusableStates();
+
+	if (bCanBeCached)
+	{
+		const int32 StateIndex = States.IndexOfByPredicate(
+			[&Actors, &ClassLayout](const TSharedRef<FLiveBlueprintSelectionState>& State)
+			{
+				return !State->bIsInUse && State->IsFor(Actors, *ClassLayout);
+			});
+
+		if (StateIndex != INDEX_NONE)
+		{
+			TSharedRef<FLiveBlueprintSelectionState> State = States[StateIndex];
+			States.RemoveAt(StateIndex);
+			States.Insert(State, 0);
+			State->bIsInUse = true;
+			return State;
+		}
+	}
+
+	TSharedRef<FLiveBlueprintSelectionState> State = MakeShared<FLiveBlueprintSelectionState>();
+	State->Actors = Actors;
+	State->ClassLayout = ClassLayout;
+	State->bIsInUse = true;
+
+	if (!bCanBeCached)
+	{
+		return State;
+	}
+
+	States.Insert(State, 0);
+
+	// Evict the least recently acquired states that are not in use. States that are in use are
+	// still counted, since they go back to the cache once their panel is rebuilt.
+	for (int32 StateIndex = States.Num() - 1; StateIndex >= 0 && States.Num() > MaxCachedStates; StateIndex--)
+	{
+		if (!States[StateIndex]->bIsInUse)
+		{
+			States.RemoveAt(StateIndex);
+		}
+	}
+
+	return State;
+}
+
+void FLiveBlueprintSelectionStateCache::Empty()
+{
+	States.Empty();
+}
+
+void FLiveBlueprintSelectionStateCache::RemoveUnusableStates()
+{
+	// The actors of a play session are all destroyed when it ends, and a recompiled class leaves its
+	// old layout stale, so neither kind of state can ever be acquired again.
+	States.RemoveAll(
+		[](const TSharedRef<FLiveBlueprintSelectionState>& State)
+		{
+			if (State->bIsInUse)
+			{
+				return false;
+			}
+
+			if (State->ClassLayout->IsStale())
+			{
+				return true;
+			}
+
+			return !State->Actors.ContainsByPredicate(
+				[](const TWeakObjectPtr<AActor>& Actor)
+				{
+					return Actor.IsValid();
+				});
+		});
+}
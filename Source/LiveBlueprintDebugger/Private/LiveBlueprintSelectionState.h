@@ -0,0 +1,89 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "LiveBlueprintRowStore.h"
+#include "LiveBlueprintSnapshotDiffer.h"
+#include "LiveBlueprintUpdateDriver.h"
+#include "LiveBlueprintUpdateScheduler.h"
+#include "LiveBlueprintValueHistory.h"
+
+class AActor;
+class FLiveBlueprintClassLayout;
+
+// FLiveBlueprintSelectionState is everything the details customization tracks for a selection of
+// actors apart from its widgets: the rows and their hashes, the last formatted value text, the value
+// history, the change times that drive highlights, and the update schedule.
+struct FLiveBlueprintSelectionState
+{
+	~FLiveBlueprintSelectionState();
+
+	bool IsFor(const TArray<TWeakObjectPtr<AActor>>& InActors, const FLiveBlueprintClassLayout& InClassLayout) const;
+	SIZE_T GetAllocatedSize() const;
+
+	// All of the selected actors have the same class.
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	TSharedPtr<const FLiveBlueprintClassLayout> ClassLayout;
+
+	// False until a customization has filled in the state for the first time. Only one
+	// customization can use a state at a time.
+	bool bIsInitialized = false;
+	bool bIsInUse = false;
+
+	FLiveBlueprintRowStore Rows;
+	TSharedRef<FLiveBlueprintValueHistory> ValueHistory = MakeShared<FLiveBlueprintValueHistory>();
+	FLiveBlueprintUpdateScheduler Scheduler;
+	FLiveBlueprintSnapshotDiffer SnapshotDiffer;
+	TBitArray<> ChangedGroupCells;
+	TBitArray<> PendingRows;
+
+	// The text last shown for each cell, so that new widgets can be bound without formatting the
+	// values again. Indexed by cell, and empty for container cells, which format their elements.
+	TArray<FText> ValueTexts;
+
+	// The reads of each instance, shared with the other panels that show the same actor. Indexed by
+	// instance, and nullptr for actors that were already destroyed.
+	TArray<TSharedPtr<FLiveBlueprintSharedReads>> SharedReads;
+
+	// The memory held by the state as last reported to the Row Memory stat.
+	SIZE_T ReportedMemorySize = 0;
+
+	// The recording session that the schema and instances were last registered with, or 0 when
+	// nothing is being recorded. Container rows are only partially hashed for display, so their
+	// full hash is tracked separately to find changes to record.
+	uint32 RecordingSessionId = 0;
+	double RecordingTimeInSeconds = 0.0;
+	TArray<uint32> RecordingInstanceIds;
+	TArray<uint32> RecordedContainerHashes;
+};
+
+// FLiveBlueprintSelectionStateCache keeps the states of the most recently customized selections.
+//
+// The details panel is rebuilt from scratch whenever the selection is refreshed, a property is
+// edited, or a component is added or removed, and the customization is destroyed along with it.
+// When the rebuilt panel shows the same actors, it picks up their state from the cache, so it only
+// has to create its widgets and bind them to the existing rows. States are keyed by the actors and
+// the generation of their class layout, so recompiling a Blueprint never reuses a state.
+//
+// States are only cached while they are being kept up-to-date by live updates. Values can still
+// change while a state sits in the cache, which the next poll of each row picks up.
+class FLiveBlueprintSelectionStateCache
+{
+public:
+	static constexpr int32 MaxCachedStates = 8;
+
+	TSharedRef<FLiveBlueprintSelectionState> Acquire(
+		const TArray<TWeakObjectPtr<AActor>>& Actors,
+		const TSharedRef<const FLiveBlueprintClassLayout>& ClassLayout,
+		bool bCanBeCached);
+
+	void Empty();
+
+private:
+	void RemoveUnusableStates();
+
+	// Ordered from most to least recently acquired.
+	TArray<TSharedRef<FLiveBlueprintSelectionState>> States;
+};
@@ -0,0 +1,182 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "LiveBlueprintSnapshotDiffer.h"
+
+#include "GameFramework/Actor.h"
+#include "LiveBlueprintDebuggerStats.h"
+#include "LiveBlueprintRowStore.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#endif
+
+void FLiveBlueprintSnapshotDiffer::Initialize(const FLiveBlueprintRowStore& Rows, const TArray<AActor*>& Objects)
+{
+	const int32 NumRows = Rows.Num();
+	NumInstances = Rows.NumInstances();
+	IsRowDiffedBits.Init(false, NumRows);
+	ChangedCells.Init(false, NumRows * NumInstances);
+
+	// Group rows are never polled themselves, but the rows of their members are.
+	int32 RegionEnd = 0;
+	RegionOffset = MAX_int32;
+
+	for (int32 RowIndex = 0; RowIndex < NumRows; RowIndex++)
+	{
+		const EPropertyValueKind ValueKind = Rows.ValueKinds[RowIndex];
+
+		if ((ValueKind == EPropertyValueKind::PlainOldData || ValueKind == EPropertyValueKind::Bool) &&
+			!Rows.IsGroupRow[RowIndex])
+		{
+			IsRowDiffedBits[RowIndex] = true;
+			RegionOffset = FMath::Min(RegionOffset, Rows.ValueOffsets[RowIndex]);
+			RegionEnd = FMath::Max(RegionEnd, Rows.ValueOffsets[RowIndex] + Rows.Properties[RowIndex]->GetSize());
+		}
+	}
+
+	if (RegionEnd == 0)
+	{
+		RegionOffset = 0;
+	}
+
+	RegionSize = RegionEnd - RegionOffset;
+
+	// Pair every row with the chunks it overlaps, then group the pairs by chunk.
+	TArray<TPair<int32, int32>> ChunkRowPairs;
+
+	for (TConstSetBitIterator<> It(IsRowDiffedBits); It; ++It)
+	{
+		const int32 RowIndex = It.GetIndex();
+		const int32 RowStart = Rows.ValueOffsets[RowIndex] - RegionOffset;
+		const int32 RowEnd = RowStart + Rows.Properties[RowIndex]->GetSize();
+
+		for (int32 ChunkIndex = RowStart / ChunkSize; ChunkIndex <= (RowEnd - 1) / ChunkSize; ChunkIndex++)
+		{
+			ChunkRowPairs.Emplace(ChunkIndex, RowIndex);
+		}
+	}
+
+	ChunkRowPairs.Sort(
+		[](const TPair<int32, int32>& A, const TPair<int32, int32>& B)
+		{
+			return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
+		});
+
+	DiffedChunks.Reset();
+	FirstChunkRows.Reset();
+	ChunkRows.Reset(ChunkRowPairs.Num());
+
+	for (const TPair<int32, int32>& ChunkRowPair : ChunkRowPairs)
+	{
+		if (DiffedChunks.Num() == 0 || DiffedChunks.Last() != ChunkRowPair.Key)
+		{
+			DiffedChunks.Add(ChunkRowPair.Key);
+			FirstChunkRows.Add(ChunkRows.Num());
+		}
+
+		ChunkRows.Add(ChunkRowPair.Value);
+	}
+
+	FirstChunkRows.Add(ChunkRows.Num());
+
+	// The snapshots start out as the current values, which the rows were filled in with.
+	Snapshots.SetNumZeroed(RegionSize * NumInstances);
+
+	for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; InstanceIndex++)
+	{
+		if (Objects[InstanceIndex] != nullptr)
+		{
+			FMemory::Memcpy(
+				Snapshots.GetData() + RegionSize * InstanceIndex,
+				reinterpret_cast<const uint8*>(Objects[InstanceIndex]) + RegionOffset,
+				RegionSize);
+		}
+	}
+}
+
+void FLiveBlueprintSnapshotDiffer::Diff(const TArray<AActor*>& Objects)
+{
+	LIVE_BLUEPRINT_SCOPE(DiffSnapshots);
+
+	for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; InstanceIndex++)
+	{
+		if (Objects[InstanceIndex] == nullptr)
+		{
+			continue;
+		}
+
+		const uint8* Region = reinterpret_cast<const uint8*>(Objects[InstanceIndex]) + RegionOffset;
+		uint8* Snapshot = Snapshots.GetData() + RegionSize * InstanceIndex;
+
+		for (int32 DiffedChunkIndex = 0; DiffedChunkIndex < DiffedChunks.Num(); DiffedChunkIndex++)
+		{
+			const int32 ChunkStart = DiffedChunks[DiffedChunkIndex] * ChunkSize;
+			const int32 ChunkBytes = FMath::Min(ChunkSize, RegionSize - ChunkStart);
+
+			// Only the last chunk of the region can be shorter than a whole chunk.
+			const bool bIsChunkEqual = (ChunkBytes == ChunkSize) ?
+				AreChunksEqual(Region + ChunkStart, Snapshot + ChunkStart) :
+				FMemory::Memcmp(Region + ChunkStart, Snapshot + ChunkStart, ChunkBytes) == 0;
+
+			if (bIsChunkEqual)
+			{
+				continue;
+			}
+
+			FMemory::Memcpy(Snapshot + ChunkStart, Region + ChunkStart, ChunkBytes);
+
+			for (int32 Index = FirstChunkRows[DiffedChunkIndex]; Index < FirstChunkRows[DiffedChunkIndex + 1]; Index++)
+			{
+				ChangedCells[ChunkRows[Index] * NumInstances + InstanceIndex] = true;
+			}
+		}
+	}
+}
+
+bool FLiveBlueprintSnapshotDiffer::IsRowDiffed(int32 RowIndex) const
+{
+	return IsRowDiffedBits.IsValidIndex(RowIndex) && IsRowDiffedBits[RowIndex];
+}
+
+bool FLiveBlueprintSnapshotDiffer::ConsumeChange(int32 CellIndex)
+{
+	const bool bChanged = ChangedCells[CellIndex];
+	ChangedCells[CellIndex] = false;
+	return bChanged;
+}
+
+SIZE_T FLiveBlueprintSnapshotDiffer::GetAllocatedSize() const
+{
+	return (
+		DiffedChunks.GetAllocatedSize() +
+		FirstChunkRows.GetAllocatedSize() +
+		ChunkRows.GetAllocatedSize() +
+		Snapshots.GetAllocatedSize() +
+		IsRowDiffedBits.GetAllocatedSize() +
+		ChangedCells.GetAllocatedSize());
+}
+
+bool FLiveBlueprintSnapshotDiffer::AreChunksEqual(const uint8* A, const uint8* B)
+{
+#if PLATFORM_CPU_X86_FAMILY
+	// Neither the object nor the snapshot region is aligned to a chunk, so unaligned loads are used.
+	const __m128i Equal0 = _mm_cmpeq_epi8(
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(A)),
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(B)));
+	const __m128i Equal1 = _mm_cmpeq_epi8(
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(A + 16)),
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(B + 16)));
+	const __m128i Equal2 = _mm_cmpeq_epi8(
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(A + 32)),
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(B + 32)));
+	const __m128i Equal3 = _mm_cmpeq_epi8(
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(A + 48)),
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(B + 48)));
+
+	const __m128i AllEqual = _mm_and_si128(_mm_and_si128(Equal0, Equal1), _mm_and_si128(Equal2, Equal3));
+
+	return _mm_movemask_epi8(AllEqual) == 0xFFFF;
+#else
+	return FMemory::Memcmp(A, B, ChunkSize) == 0;
+#endif
+}
@@ -0,0 +1,59 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+struct FLiveBlueprintRowStore;
+
+// FLiveBlueprintSnapshotDiffer finds which plain-old-data and bool rows changed by comparing the
+// memory of every selected object against a snapshot of it, instead of hashing every row.
+//
+// The variables of a Blueprint class, including the members of its struct variables, sit in one
+// region of the object. The region is split into 64 byte chunks, and a table built once in
+// Initialize lists the rows that overlap each chunk. Diff compares only the chunks that hold rows,
+// 64 bytes at a time with SSE2 where available, copies the chunks that changed into the snapshot,
+// and marks the cells of the rows that overlap them. Checking hundreds of variables this way only
+// touches a few cache lines per object.
+//
+// A chunk also holds bytes of neighboring variables and padding, so a changed cell can still turn
+// out to have the same value once it is hashed.
+class FLiveBlueprintSnapshotDiffer
+{
+public:
+	static constexpr int32 ChunkSize = 64;
+
+	void Initialize(const FLiveBlueprintRowStore& Rows, const TArray<AActor*>& Objects);
+	void Diff(const TArray<AActor*>& Objects);
+
+	bool IsRowDiffed(int32 RowIndex) const;
+
+	// Returns whether the cell changed since it was last consumed, and clears the change.
+	bool ConsumeChange(int32 CellIndex);
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	static bool AreChunksEqual(const uint8* A, const uint8* B);
+
+	int32 NumInstances = 0;
+	int32 RegionOffset = 0;
+	int32 RegionSize = 0;
+
+	// The chunks that hold at least one row, relative to the start of the region, and the rows that
+	// overlap them. The rows of DiffedChunks[I] are ChunkRows[FirstChunkRows[I]] up to
+	// ChunkRows[FirstChunkRows[I + 1]].
+	TArray<int32> DiffedChunks;
+	TArray<int32> FirstChunkRows;
+	TArray<int32> ChunkRows;
+
+	// One copy of the region per instance.
+	TArray<uint8> Snapshots;
+
+	// Indexed by row.
+	TBitArray<> IsRowDiffedBits;
+
+	// Indexed by cell.
+	TBitArray<> ChangedCells;
+};
@@ -0,0 +1,163 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "LiveBlueprintUpdateDriver.h"
+
+#include "Editor.h"
+#include "LiveBlueprintClassLayout.h"
+#include "LiveBlueprintDebuggerDetailCustomization.h"
+#include "LiveBlueprintDebuggerStats.h"
+
+FLiveBlueprintUpdateDriver& FLiveBlueprintUpdateDriver::Get()
+{
+	static FLiveBlueprintUpdateDriver Instance;
+	return Instance;
+}
+
+void FLiveBlueprintUpdateDriver::Register(FLiveBlueprintDebuggerDetailCustomization* Customization)
+{
+	Customizations.AddUnique(Customization);
+
+	// The ticker is only registered while there is something to update.
+	if (!TickerHandle.IsValid())
+	{
+#if ENGINE_MAJOR_VERSION == 5
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FLiveBlueprintUpdateDriver::Tick));
+#else
+		TickerHandle = FTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FLiveBlueprintUpdateDriver::Tick));
+#endif
+	}
+
+	if (!OnBlueprintPreCompileDelegateHandle.IsValid() && GEditor != nullptr)
+	{
+		OnBlueprintPreCompileDelegateHandle = GEditor->OnBlueprintPreCompile().AddRaw(
+			this, &FLiveBlueprintUpdateDriver::OnBlueprintPreCompile);
+	}
+
+	// Collecting garbage frees the properties of classes that were replaced by a recompile or a
+	// reload.
+	if (!OnPreGarbageCollectDelegateHandle.IsValid())
+	{
+		OnPreGarbageCollectDelegateHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(
+			this, &FLiveBlueprintUpdateDriver::WaitForFormatting);
+	}
+}
+
+void FLiveBlueprintUpdateDriver::Unregister(FLiveBlueprintDebuggerDetailCustomization* Customization)
+{
+	Customizations.Remove(Customization);
+
+	if (Customizations.Num() == 0)
+	{
+		Shutdown();
+	}
+}
+
+void FLiveBlueprintUpdateDriver::Shutdown()
+{
+	if (TickerHandle.IsValid())
+	{
+#if ENGINE_MAJOR_VERSION == 5
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+#else
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+#endif
+		TickerHandle.Reset();
+	}
+
+	if (OnBlueprintPreCompileDelegateHandle.IsValid() && GEditor != nullptr)
+	{
+		GEditor->OnBlueprintPreCompile().Remove(OnBlueprintPreCompileDelegateHandle);
+	}
+
+	OnBlueprintPreCompileDelegateHandle.Reset();
+
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(OnPreGarbageCollectDelegateHandle);
+	OnPreGarbageCollectDelegateHandle.Reset();
+
+	SharedReads.Empty();
+}
+
+TSharedRef<FLiveBlueprintSharedReads> FLiveBlueprintUpdateDriver::FindOrAddSharedReads(
+	const FLiveBlueprintClassLayout& ClassLayout,
+	const AActor* Actor)
+{
+	const TPair<const FLiveBlueprintClassLayout*, FObjectKey> Key{ &ClassLayout, FObjectKey(Actor) };
+
+	if (TWeakPtr<FLiveBlueprintSharedReads>* ExistingReads = SharedReads.Find(Key); ExistingReads != nullptr)
+	{
+		if (TSharedPtr<FLiveBlueprintSharedReads> PinnedReads = ExistingReads->Pin(); PinnedReads.IsValid())
+		{
+			return PinnedReads.ToSharedRef();
+		}
+	}
+
+	// Reads are requested whenever a panel is rebuilt, which is rare enough to clean up the reads of
+	// actors that are no longer shown here.
+	for (auto It = SharedReads.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// No frame has read the rows yet.
+	TSharedRef<FLiveBlueprintSharedReads> Reads = MakeShared<FLiveBlueprintSharedReads>();
+	Reads->ValueHashes.Init(0, ClassLayout.GetProperties().Num());
+	Reads->ReadFrames.Init(MAX_uint64, ClassLayout.GetProperties().Num());
+
+	SharedReads.Add(Key, Reads);
+
+	return Reads;
+}
+
+bool FLiveBlueprintUpdateDriver::Tick(float /*DeltaTime*/)
+{
+	// The per-update counters are summed over every customization in the pass.
+	TRACE_COUNTER_SET(LiveBlueprint_RowsPolled, 0);
+	TRACE_COUNTER_SET(LiveBlueprint_RowsUpdated, 0);
+	TRACE_COUNTER_SET(LiveBlueprint_RowsSkipped, 0);
+
+	// Updating a customization never creates or destroys one, but index the array anyway so that a
+	// customization going away mid-pass can't invalidate the loop.
+	for (int32 Index = 0; Index < Customizations.Num(); Index++)
+	{
+		Customizations[Index]->UpdateBlueprintDetails();
+	}
+
+	return true;
+}
+
+void FLiveBlueprintUpdateDriver::WaitForFormatting()
+{
+	for (FLiveBlueprintDebuggerDetailCustomization* Customization : Customizations)
+	{
+		Customization->WaitForFormatting();
+	}
+}
+
+void FLiveBlueprintUpdateDriver::OnBlueprintPreCompile(UBlueprint* /*Blueprint*/)
+{
+	// Any Blueprint can be compiled, not just the classes being shown, since their properties can
+	// refer to enums and structs of other Blueprints.
+	WaitForFormatting();
+}
+
+void FLiveBlueprintUpdateDriver::PreChange(
+	const UUserDefinedStruct* /*Struct*/, 
+	FStructureEditorUtils::EStructureEditorChangeInfo /*ChangeInfo*/)
+{
+	// The properties of a user-defined struct are destroyed and rebuilt as soon as it is changed,
+	// before the Blueprints that use it are compiled.
+	WaitForFormatting();
+}
+
+void FLiveBlueprintUpdateDriver::PreChange(
+	const UUserDefinedEnum* /*Enum*/, 
+	FEnumEditorUtils::EEnumEditorChangeInfo /*ChangeInfo*/)
+{
+	// The names of a user-defined enum are replaced in place when it is changed.
+	WaitForFormatting();
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Kismet2/EnumEditorUtils.h"
+#include "Kismet2/StructureEditorUtils.h"
+#include "UObject/ObjectKey.h"
+
+class FLiveBlueprintClassLayout;
+class FLiveBlueprintDebuggerDetailCustomization;
+class UBlueprint;
+
+// The value hashes of one actor's rows, shared by every details panel that shows the actor. A row
+// is only hashed by the first panel that polls it in a frame, and the other panels reuse the hash.
+struct FLiveBlueprintSharedReads
+{
+	// Indexed by row.
+	TArray<uint32> ValueHashes;
+	TArray<uint64> ReadFrames;
+};
+
+// FLiveBlueprintUpdateDriver updates every open Blueprint details customization in one pass per
+// frame, instead of each one scheduling its own timer.
+//
+// Several details panels can be open at once, and locked panels can keep showing actors that are no
+// longer selected, so the same actor may be customized more than once. The driver hands out the
+// reads of each actor, keyed by the class layout and the actor, so that its rows are only read once
+// per frame no matter how many panels show them.
+//
+// Values are formatted on worker threads across frames, so the driver also waits for that work to
+// finish while the properties it reads still exist: before any Blueprint is compiled, before a
+// user-defined struct or enum is changed in place, and before garbage collection.
+class FLiveBlueprintUpdateDriver : 
+	public FStructureEditorUtils::FStructEditorManager::ListenerType, 
+	public FEnumEditorUtils::FEnumEditorManager::ListenerType
+{
+public:
+	static FLiveBlueprintUpdateDriver& Get();
+
+	void Register(FLiveBlueprintDebuggerDetailCustomization* Customization);
+	void Unregister(FLiveBlueprintDebuggerDetailCustomization* Customization);
+	void Shutdown();
+
+	TSharedRef<FLiveBlueprintSharedReads> FindOrAddSharedReads(const FLiveBlueprintClassLayout& ClassLayout, const AActor* Actor);
+
+private:
+	bool Tick(float DeltaTime);
+	void WaitForFormatting();
+	void OnBlueprintPreCompile(UBlueprint* Blueprint);
+
+	virtual void PreChange(const class UUserDefinedStruct* Struct, FStructureEditorUtils::EStructureEditorChangeInfo ChangeInfo) override;
+	virtual void PostChange(const class UUserDefinedStruct* Struct, FStructureEditorUtils::EStructureEditorChangeInfo ChangeInfo) override {}
+	virtual void PreChange(const class UUserDefinedEnum* Enum, FEnumEditorUtils::EEnumEditorChangeInfo ChangeInfo) override;
+	virtual void PostChange(const class UUserDefinedEnum* Enum, FEnumEditorUtils::EEnumEditorChangeInfo ChangeInfo) override {}
+
+	TArray<FLiveBlueprintDebuggerDetailCustomization*> Customizations;
+
+	// The reads are owned by the customizations, so they go away with the last panel that shows the
+	// actor. The class layout is part of the key so that reads never outlive a recompile.
+	TMap<TPair<const FLiveBlueprintClassLayout*, FObjectKey>, TWeakPtr<FLiveBlueprintSharedReads>> SharedReads;
+
+#if ENGINE_MAJOR_VERSION == 5
+	FTSTicker::FDelegateHandle TickerHandle;
+#else
+	FDelegateHandle TickerHandle;
+#endif
+	FDelegateHandle OnBlueprintPreCompileDelegateHandle;
+	FDelegateHandle OnPreGarbageCollectDelegateHandle;
+};
@@ -0,0 +1,163 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "LiveBlueprintUpdateScheduler.h"
+
+#include "HAL/PlatformTime.h"
+
+void FLiveBlueprintUpdateScheduler::Initialize(
+	const TArray<bool>& InIsRowSchedulable,
+	const TArray<double>& InRowRefreshPeriodsInSeconds,
+	const TArray<bool>& InIsRowAdaptive,
+	double InBudgetInSeconds)
+{
+	const int32 NumRows = InIsRowSchedulable.Num();
+
+	check(InRowRefreshPeriodsInSeconds.Num() == NumRows);
+	check(InIsRowAdaptive.Num() == NumRows);
+
+	BudgetInSeconds = InBudgetInSeconds;
+	Cursor = 0;
+	IsRowSchedulable = InIsRowSchedulable;
+	IsRowAdaptive = InIsRowAdaptive;
+	RowRefreshPeriods = InRowRefreshPeriodsInSeconds;
+	PollIntervals = InRowRefreshPeriodsInSeconds;
+	NextPollTimes.SetNumZeroed(NumRows);
+	LastChangeTimes.SetNumZeroed(NumRows);
+	IsHotRow.Init(false, NumRows);
+	HotRows.Reset();
+}
+
+void FLiveBlueprintUpdateScheduler::Tick(
+	double CurrentTimeInSeconds, 
+	TFunctionRef<bool(int32 RowIndex)> IsRowVisible, 
+	TFunctionRef<bool(int32 RowIndex)> PollRowFunction)
+{
+	const int32 NumRows = NextPollTimes.Num();
+
+	if (NumRows == 0)
+	{
+		return;
+	}
+
+	const double BudgetEndTime = FPlatformTime::Seconds() + BudgetInSeconds;
+	auto IsOverBudget = [this, BudgetEndTime]()
+	{
+		return (BudgetInSeconds > 0.0) && (FPlatformTime::Seconds() >= BudgetEndTime);
+	};
+
+	ExpireHotRows(CurrentTimeInSeconds);
+
+	// Hot rows go first. Polling a hot row can only refresh its change time, so HotRows does not
+	// change size while we iterate over it.
+	for (int32 HotIndex = 0; HotIndex < HotRows.Num() && !IsOverBudget(); HotIndex++)
+	{
+		const int32 RowIndex = HotRows[HotIndex];
+
+		if (IsRowDue(RowIndex, CurrentTimeInSeconds) && IsRowVisible(RowIndex))
+		{
+			PollRow(RowIndex, CurrentTimeInSeconds, PollRowFunction);
+		}
+	}
+
+	// Then continue the round-robin over the remaining rows from wherever the previous frame ran
+	// out of budget. At least one of them is polled even if the hot rows used up the whole budget,
+	// so that the cursor keeps moving and rows that aren't hot are never starved.
+	int32 NumRoundRobinPolls = 0;
+
+	for (int32 NumVisitedRows = 0; NumVisitedRows < NumRows; NumVisitedRows++)
+	{
+		const int32 RowIndex = Cursor;
+
+		if (IsRowDue(RowIndex, CurrentTimeInSeconds) && !IsHotRow[RowIndex] && IsRowVisible(RowIndex))
+		{
+			if (NumRoundRobinPolls > 0 && IsOverBudget())
+			{
+				break;
+			}
+
+			PollRow(RowIndex, CurrentTimeInSeconds, PollRowFunction);
+			NumRoundRobinPolls++;
+		}
+
+		Cursor = (Cursor + 1) % NumRows;
+	}
+}
+
+void FLiveBlueprintUpdateScheduler::MarkRowChanged(int32 RowIndex, double CurrentTimeInSeconds)
+{
+	LastChangeTimes[RowIndex] = CurrentTimeInSeconds;
+	UpdatePollInterval(RowIndex, true);
+
+	if (!IsHotRow[RowIndex])
+	{
+		IsHotRow[RowIndex] = true;
+		HotRows.Add(RowIndex);
+	}
+}
+
+void FLiveBlueprintUpdateScheduler::MarkAllDue(double CurrentTimeInSeconds)
+{
+	for (double& NextPollTime : NextPollTimes)
+	{
+		NextPollTime = FMath::Min(NextPollTime, CurrentTimeInSeconds);
+	}
+}
+
+const TArray<int32>& FLiveBlueprintUpdateScheduler::GetHotRows() const
+{
+	return HotRows;
+}
+
+bool FLiveBlueprintUpdateScheduler::IsRowDue(int32 RowIndex, double CurrentTimeInSeconds) const
+{
+	return IsRowSchedulable[RowIndex] && (NextPollTimes[RowIndex] <= CurrentTimeInSeconds);
+}
+
+void FLiveBlueprintUpdateScheduler::PollRow(
+	int32 RowIndex,
+	double CurrentTimeInSeconds,
+	TFunctionRef<bool(int32 RowIndex)> PollRowFunction)
+{
+	if (PollRowFunction(RowIndex))
+	{
+		MarkRowChanged(RowIndex, CurrentTimeInSeconds);
+	}
+	else
+	{
+		UpdatePollInterval(RowIndex, false);
+	}
+
+	NextPollTimes[RowIndex] = CurrentTimeInSeconds + PollIntervals[RowIndex];
+}
+
+void FLiveBlueprintUpdateScheduler::UpdatePollInterval(int32 RowIndex, bool bRowChanged)
+{
+	if (!IsRowAdaptive[RowIndex])
+	{
+		return;
+	}
+
+	if (bRowChanged)
+	{
+		PollIntervals[RowIndex] = RowRefreshPeriods[RowIndex];
+	}
+	else
+	{
+		const double MaxPollInterval = FMath::Max(RowRefreshPeriods[RowIndex], MaxAdaptiveRefreshPeriodInSeconds);
+		PollIntervals[RowIndex] = FMath::Min(PollIntervals[RowIndex] * 2.0, MaxPollInterval);
+	}
+}
+
+void FLiveBlueprintUpdateScheduler::ExpireHotRows(double CurrentTimeInSeconds)
+{
+	for (int32 HotIndex = HotRows.Num() - 1; HotIndex >= 0; HotIndex--)
+	{
+		const int32 RowIndex = HotRows[HotIndex];
+
+		if (CurrentTimeInSeconds - LastChangeTimes[RowIndex] > HotRowDurationInSeconds)
+		{
+			IsHotRow[RowIndex] = false;
+			HotRows.RemoveAtSwap(HotIndex);
+		}
+	}
+}
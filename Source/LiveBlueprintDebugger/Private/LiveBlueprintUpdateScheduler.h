@@ -0,0 +1,71 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// FLiveBlueprintUpdateScheduler decides which rows get updated on each frame.
+//
+// Every row is polled once per refresh period, but instead of polling all rows in a single frame,
+// rows are visited round-robin and the work done per frame is capped by a time budget. Rows that
+// are not reached before the budget runs out are picked up on the next frame. Rows that changed
+// recently ("hot" rows) are always polled first, so the values the user is most likely watching
+// stay responsive even when the budget is exhausted. At least one other due row is still polled
+// on every frame, so a budget used up by hot rows slows the remaining rows down but never stops them.
+//
+// Each row has its own refresh period. Adaptive rows learn how often they change: every poll that
+// finds the value unchanged doubles the row's poll interval, up to MaxAdaptiveRefreshPeriodInSeconds,
+// and a change drops it straight back to the row's refresh period. Rows that never change, such as
+// configuration values and references that are set once, end up being polled only rarely.
+//
+// Rows that aren't visible are skipped without being polled. They stay due, so they catch up as
+// soon as they become visible again.
+class FLiveBlueprintUpdateScheduler
+{
+public:
+	// How long a row stays hot after it last changed. This matches the duration of the highlight
+	// animation, so hot rows are also the rows whose highlight needs updating.
+	static constexpr double HotRowDurationInSeconds = 2.0;
+
+	// The longest an adaptive row can go without being polled. Rows whose refresh period is already
+	// longer than this are never slowed down further.
+	static constexpr double MaxAdaptiveRefreshPeriodInSeconds = 2.0;
+
+	void Initialize(
+		const TArray<bool>& IsRowSchedulable, 
+		const TArray<double>& RowRefreshPeriodsInSeconds, 
+		const TArray<bool>& IsRowAdaptive, 
+		double BudgetInSeconds);
+
+	// Polls the visible rows that are due at CurrentTimeInSeconds. PollRow returns true if the row
+	// changed.
+	void Tick(
+		double CurrentTimeInSeconds, 
+		TFunctionRef<bool(int32 RowIndex)> IsRowVisible, 
+		TFunctionRef<bool(int32 RowIndex)> PollRow);
+
+	void MarkRowChanged(int32 RowIndex, double CurrentTimeInSeconds);
+
+	// Makes every row due at CurrentTimeInSeconds, for when the rows may have changed while nothing
+	// was polling them.
+	void MarkAllDue(double CurrentTimeInSeconds);
+	const TArray<int32>& GetHotRows() const;
+
+private:
+	bool IsRowDue(int32 RowIndex, double CurrentTimeInSeconds) const;
+	void PollRow(int32 RowIndex, double CurrentTimeInSeconds, TFunctionRef<bool(int32 RowIndex)> PollRowFunction);
+	void ExpireHotRows(double CurrentTimeInSeconds);
+
+	void UpdatePollInterval(int32 RowIndex, bool bRowChanged);
+
+	double BudgetInSeconds = 0.0;
+	int32 Cursor = 0;
+	TArray<bool> IsRowSchedulable;
+	TArray<bool> IsRowAdaptive;
+	TArray<double> RowRefreshPeriods;
+	TArray<double> PollIntervals;
+	TArray<double> NextPollTimes;
+	TArray<double> LastChangeTimes;
+	TBitArray<> IsHotRow;
+	TArray<int32> HotRows;
+};
@@ -0,0 +1,188 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "LiveBlueprintValueAccessor.h"
+
+#include "Hash/CityHash.h"
+
+// Scalars are hashed by their bits, the same as FPropertyValueHasher hashes plain-old-data. Values
+// of up to four bytes are their own hash, so none of their changes can be missed.
+template<typename BitsType>
+static uint32 HashBits(const FProperty* /*Property*/, const void* ValuePointer)
+{
+	BitsType Bits;
+	FMemory::Memcpy(&Bits, ValuePointer, sizeof(Bits));
+	return GetTypeHash(Bits);
+}
+
+template<typename StructType>
+static uint32 HashStructBytes(const FProperty* /*Property*/, const void* ValuePointer)
+{
+	return CityHash32(static_cast<const char*>(ValuePointer), sizeof(StructType));
+}
+
+static uint32 HashBool(const FProperty* Property, const void* ValuePointer)
+{
+	return static_cast<const FBoolProperty*>(Property)->GetPropertyValue(ValuePointer) ? 1 : 0;
+}
+
+static uint32 HashName(const FProperty* /*Property*/, const void* ValuePointer)
+{
+	return GetTypeHash(*static_cast<const FName*>(ValuePointer));
+}
+
+template<EPropertyValueKind ValueKind>
+static uint32 HashValueOfKind(const FProperty* Property, const void* ValuePointer)
+{
+	return FPropertyValueHasher::HashValue(ValueKind, Property, ValuePointer);
+}
+
+template<typename ValueType>
+static double ReadNumber(const FProperty* /*Property*/, const void* ValuePointer)
+{
+	return static_cast<double>(*static_cast<const ValueType*>(ValuePointer));
+}
+
+static double ReadBool(const FProperty* Property, const void* ValuePointer)
+{
+	return static_cast<const FBoolProperty*>(Property)->GetPropertyValue(ValuePointer) ? 1.0 : 0.0;
+}
+
+template<typename ValueType, typename BitsType>
+static FLiveBlueprintValueAccessor MakeNumericAccessor()
+{
+	static_assert(sizeof(ValueType) == sizeof(BitsType), "Numbers must be hashed by all of their bits.");
+
+	return { &HashBits<BitsType>, &ReadNumber<ValueType> };
+}
+
+FLiveBlueprintValueAccessor FLiveBlueprintValueAccessor::Compile(const FProperty* Property, EPropertyValueKind ValueKind)
+{
+	if (ValueKind == EPropertyValueKind::Bool)
+	{
+		return { &HashBool, &ReadBool };
+	}
+	else if (ValueKind == EPropertyValueKind::Name)
+	{
+		return { &HashName, nullptr };
+	}
+
+	// Enums are read through the integer property that holds their value.
+	const FProperty* NumericProperty = Property;
+
+	if (auto EnumProperty = CastField<FEnumProperty>(Property); EnumProperty != nullptr)
+	{
+		NumericProperty = EnumProperty->GetUnderlyingProperty();
+	}
+
+	if (NumericProperty->IsA<FByteProperty>())
+	{
+		return MakeNumericAccessor<uint8, uint8>();
+	}
+	else if (NumericProperty->IsA<FInt8Property>())
+	{
+		return MakeNumericAccessor<int8, uint8>();
+	}
+	else if (NumericProperty->IsA<FInt16Property>())
+	{
+		return MakeNumericAccessor<int16, uint16>();
+	}
+	else if (NumericProperty->IsA<FUInt16Property>())
+	{
+		return MakeNumericAccessor<uint16, uint16>();
+	}
+	else if (NumericProperty->IsA<FIntProperty>())
+	{
+		return MakeNumericAccessor<int32, uint32>();
+	}
+	else if (NumericProperty->IsA<FUInt32Property>())
+	{
+		return MakeNumericAccessor<uint32, uint32>();
+	}
+	else if (NumericProperty->IsA<FInt64Property>())
+	{
+		return MakeNumericAccessor<int64, uint64>();
+	}
+	else if (NumericProperty->IsA<FUInt64Property>())
+	{
+		return MakeNumericAccessor<uint64, uint64>();
+	}
+	else if (NumericProperty->IsA<FFloatProperty>())
+	{
+		return MakeNumericAccessor<float, uint32>();
+	}
+	else if (NumericProperty->IsA<FDoubleProperty>())
+	{
+		return MakeNumericAccessor<double, uint64>();
+	}
+
+	switch (ValueKind)
+	{
+		case EPropertyValueKind::PlainOldData:
+		{
+			// The most common structs have a fixed size, so hashing them doesn't need to look up the
+			// size of the property.
+			const UScriptStruct* Struct = CastFieldChecked<FStructProperty>(Property)->Struct;
+
+			if (Struct == TBaseStructure<FVector>::Get())
+			{
+				return { &HashStructBytes<FVector>, nullptr };
+			}
+			else if (Struct == TBaseStructure<FRotator>::Get())
+			{
+				return { &HashStructBytes<FRotator>, nullptr };
+			}
+			else if (Struct == TBaseStructure<FTransform>::Get())
+			{
+				return { &HashStructBytes<FTransform>, nullptr };
+			}
+
+			return { &HashValueOfKind<EPropertyValueKind::PlainOldData>, nullptr };
+		}
+
+		case EPropertyValueKind::String:
+		{
+			return { &HashValueOfKind<EPropertyValueKind::String>, nullptr };
+		}
+
+		case EPropertyValueKind::Text:
+		{
+			return { &HashValueOfKind<EPropertyValueKind::Text>, nullptr };
+		}
+
+		case EPropertyValueKind::Object:
+		{
+			return { &HashValueOfKind<EPropertyValueKind::Object>, nullptr };
+		}
+
+		case EPropertyValueKind::Interface:
+		{
+			return { &HashValueOfKind<EPropertyValueKind::Interface>, nullptr };
+		}
+
+		case EPropertyValueKind::Struct:
+		{
+			return { &HashValueOfKind<EPropertyValueKind::Struct>, nullptr };
+		}
+
+		case EPropertyValueKind::Array:
+		{
+			return { &HashValueOfKind<EPropertyValueKind::Array>, nullptr };
+		}
+
+		case EPropertyValueKind::Map:
+		{
+			return { &HashValueOfKind<EPropertyValueKind::Map>, nullptr };
+		}
+
+		case EPropertyValueKind::Set:
+		{
+			return { &HashValueOfKind<EPropertyValueKind::Set>, nullptr };
+		}
+
+		default:
+		case EPropertyValueKind::Other:
+		{
+			return { &HashValueOfKind<EPropertyValueKind::Other>, nullptr };
+		}
+	}
+}
@@ -0,0 +1,30 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "PropertyValueHasher.h"
+
+// FLiveBlueprintValueAccessor holds the functions that read the value of one property, chosen once
+// for the property's type when the class layout is built.
+//
+// Numbers, enums, bools, names, vectors, rotators, and transforms get functions specialized for
+// their exact type, which read the value directly without querying the reflection system or
+// switching on the kind of value. Every other type falls back to FPropertyValueHasher with its
+// value kind fixed at compile time. Accessors belong to the class layout, so they are only chosen
+// again once the Blueprint has been recompiled and the layout has gone stale.
+struct FLiveBlueprintValueAccessor
+{
+	using FHashFunction = uint32 (*)(const FProperty* Property, const void* ValuePointer);
+	using FReadNumberFunction = double (*)(const FProperty* Property, const void* ValuePointer);
+
+	static FLiveBlueprintValueAccessor Compile(const FProperty* Property, EPropertyValueKind ValueKind);
+
+	// The change-detection hash of the value. Hashes from different accessors can't be compared.
+	FHashFunction Hash = nullptr;
+
+	// The value as a number for history graphs and sorting, or nullptr for properties that are
+	// not numbers, enums, or bools.
+	FReadNumberFunction ReadNumber = nullptr;
+};
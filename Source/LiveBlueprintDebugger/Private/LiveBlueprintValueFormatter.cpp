@@ -0,0 +1,284 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "LiveBlueprintValueFormatter.h"
+
+#include "Async/Async.h"
+#include "FastPropertyInstanceInfo.h"
+#include "LiveBlueprintDebuggerStats.h"
+#include "LiveBlueprintRowStore.h"
+
+FLiveBlueprintValueFormatter::~FLiveBlueprintValueFormatter()
+{
+	Cancel();
+}
+
+void FLiveBlueprintValueFormatter::Initialize(const FLiveBlueprintRowStore& Rows)
+{
+	Cancel();
+
+	const int32 NumRows = Rows.Num();
+	NumInstances = Rows.NumInstances();
+	Properties = TArray<const FProperty*>(Rows.Properties.GetData(), Rows.Properties.Num());
+	SlotOffsets.Init(INDEX_NONE, NumRows);
+	SlotSizes.Init(0, NumRows);
+	SlotStrides.Init(0, NumRows);
+	KeyProperties.Init(nullptr, NumRows);
+	BoolProperties.Init(nullptr, NumRows);
+	TableIndices.Init(INDEX_NONE, NumRows);
+	Tables.Reset();
+
+	// Tables are keyed by the class of the property as well as the enum, since byte and enum
+	// properties of the same enum don't have to be formatted the same way. Bools use no enum.
+	TMap<TPair<const FFieldClass*, const UEnum*>, int32> TableIndicesByEnum;
+
+	// Every instance of a row gets its own slot, aligned for the property so that the worker can
+	// read the copy in place.
+	int32 StagingSize = 0;
+
+	for (int32 RowIndex = 0; RowIndex < NumRows; RowIndex++)
+	{
+		const FProperty* Property = Properties[RowIndex];
+		const UEnum* Enum = nullptr;
+
+		if (Rows.ValueKinds[RowIndex] == EPropertyValueKind::Bool)
+		{
+			BoolProperties[RowIndex] = CastField<FBoolProperty>(Property);
+		}
+		else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+		{
+			KeyProperties[RowIndex] = EnumProperty->GetUnderlyingProperty();
+			Enum = EnumProperty->GetEnum();
+		}
+		else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			Enum = NumericProperty->GetIntPropertyEnum();
+			KeyProperties[RowIndex] = (Enum != nullptr) ? NumericProperty : nullptr;
+		}
+
+		// Structs are formatted from the display names of their members, so only plain numbers,
+		// enums, and bools can be formatted on the worker.
+		const bool bIsNumber = Property->IsA<FNumericProperty>() && KeyProperties[RowIndex] == nullptr;
+		const bool bHasTable = (BoolProperties[RowIndex] != nullptr) || (KeyProperties[RowIndex] != nullptr && Enum != nullptr);
+
+		if (!bIsNumber && !bHasTable)
+		{
+			continue;
+		}
+
+		if (bHasTable)
+		{
+			const TPair<const FFieldClass*, const UEnum*> TableKey{ Property->GetClass(), Enum };
+
+			if (const int32* ExistingTableIndex = TableIndicesByEnum.Find(TableKey))
+			{
+				TableIndices[RowIndex] = *ExistingTableIndex;
+			}
+			else
+			{
+				TableIndices[RowIndex] = Tables.Num();
+				TableIndicesByEnum.Add(TableKey, Tables.Num());
+				TMap<int64, FText>& Table = Tables.AddDefaulted_GetRef();
+
+				// Enums and bools are at most 8 bytes, and bitfield bools live within their field.
+				uint64 Value = 0;
+
+				if (BoolProperties[RowIndex] != nullptr)
+				{
+					for (int64 Key = 0; Key <= 1; Key++)
+					{
+						BoolProperties[RowIndex]->SetPropertyValue(&Value, Key != 0);
+						Table.Add(Key, FormatProperty(Property, &Value));
+					}
+				}
+				else
+				{
+					for (int32 EnumIndex = 0; EnumIndex < Enum->NumEnums(); EnumIndex++)
+					{
+						const int64 Key = Enum->GetValueByIndex(EnumIndex);
+						KeyProperties[RowIndex]->SetIntPropertyValue(&Value, Key);
+						Table.Add(Key, FormatProperty(Property, &Value));
+					}
+				}
+			}
+		}
+
+		const int32 Alignment = FMath::Max(Property->GetMinAlignment(), 1);
+
+		StagingSize = Align(StagingSize, Alignment);
+		SlotOffsets[RowIndex] = StagingSize;
+		SlotSizes[RowIndex] = Property->GetSize();
+		SlotStrides[RowIndex] = Align(Property->GetSize(), Alignment);
+		StagingSize += SlotStrides[RowIndex] * NumInstances;
+	}
+
+	const int32 NumCells = NumRows * NumInstances;
+
+	for (FBatch& Batch : Batches)
+	{
+		Batch.Staging.SetNumUninitialized(StagingSize);
+		Batch.CellIndices.Empty(NumCells);
+		Batch.ValueTexts.Empty();
+	}
+
+	SnapshotBatchIndex = 0;
+	IsCellInSnapshotBatch.Init(false, NumCells);
+}
+
+bool FLiveBlueprintValueFormatter::CanFormat(int32 RowIndex) const
+{
+	return SlotOffsets.IsValidIndex(RowIndex) && SlotOffsets[RowIndex] != INDEX_NONE;
+}
+
+FText FLiveBlueprintValueFormatter::FormatOnGameThread(int32 RowIndex, const void* ValuePointer) const
+{
+	check(IsInGameThread());
+
+	FText ValueText;
+
+	if (!TryFormat(RowIndex, ValuePointer, ValueText))
+	{
+		ValueText = FormatProperty(Properties[RowIndex], ValuePointer);
+	}
+
+	return ValueText;
+}
+
+bool FLiveBlueprintValueFormatter::Snapshot(int32 RowIndex, int32 InstanceIndex, const void* ValuePointer)
+{
+	if (TableIndices[RowIndex] != INDEX_NONE && FindTableText(RowIndex, ValuePointer) == nullptr)
+	{
+		return false;
+	}
+
+	FBatch& Batch = Batches[SnapshotBatchIndex];
+
+	FMemory::Memcpy(
+		GetSlotPointer(Batch, RowIndex, InstanceIndex),
+		ValuePointer,
+		SlotSizes[RowIndex]);
+
+	const int32 CellIndex = RowIndex * NumInstances + InstanceIndex;
+
+	if (!IsCellInSnapshotBatch[CellIndex])
+	{
+		IsCellInSnapshotBatch[CellIndex] = true;
+		Batch.CellIndices.Add(CellIndex);
+	}
+
+	return true;
+}
+
+void FLiveBlueprintValueFormatter::Dispatch()
+{
+	FBatch& Batch = Batches[SnapshotBatchIndex];
+
+	// The other staging buffer is still in use until the results of the last batch are applied.
+	if (Batch.CellIndices.Num() == 0 || FormattingTask.IsValid())
+	{
+		return;
+	}
+
+	for (int32 CellIndex : Batch.CellIndices)
+	{
+		IsCellInSnapshotBatch[CellIndex] = false;
+	}
+
+	FBatch* FormattingBatch = &Batch;
+	SnapshotBatchIndex ^= 1;
+
+	FormattingTask = Async(
+		EAsyncExecution::ThreadPool,
+		[this, FormattingBatch]()
+		{
+			FormatBatch(*FormattingBatch);
+		});
+}
+
+void FLiveBlueprintValueFormatter::Wait()
+{
+	// The results are applied on the next update as usual.
+	if (FormattingTask.IsValid())
+	{
+		FormattingTask.Wait();
+	}
+}
+
+void FLiveBlueprintValueFormatter::Cancel()
+{
+	if (FormattingTask.IsValid())
+	{
+		FormattingTask.Wait();
+		FormattingTask = TFuture<void>();
+	}
+
+	for (FBatch& Batch : Batches)
+	{
+		Batch.CellIndices.Reset();
+		Batch.ValueTexts.Reset();
+	}
+
+	IsCellInSnapshotBatch.Init(false, IsCellInSnapshotBatch.Num());
+}
+
+uint8* FLiveBlueprintValueFormatter::GetSlotPointer(FBatch& Batch, int32 RowIndex, int32 InstanceIndex) const
+{
+	return Batch.Staging.GetData() + SlotOffsets[RowIndex] + SlotStrides[RowIndex] * InstanceIndex;
+}
+
+void FLiveBlueprintValueFormatter::FormatBatch(FBatch& Batch) const
+{
+	LIVE_BLUEPRINT_SCOPE(FormatValueOnWorker);
+
+	Batch.ValueTexts.SetNum(Batch.CellIndices.Num());
+
+	for (int32 Index = 0; Index < Batch.CellIndices.Num(); Index++)
+	{
+		const int32 RowIndex = Batch.CellIndices[Index] / NumInstances;
+		const int32 InstanceIndex = Batch.CellIndices[Index] % NumInstances;
+
+		// Snapshot only takes values that are in their table, so this always succeeds.
+		verify(TryFormat(RowIndex, GetSlotPointer(Batch, RowIndex, InstanceIndex), Batch.ValueTexts[Index]));
+	}
+}
+
+const FText* FLiveBlueprintValueFormatter::FindTableText(int32 RowIndex, const void* ValuePointer) const
+{
+	const int64 Key = (BoolProperties[RowIndex] != nullptr) ? 
+		(BoolProperties[RowIndex]->GetPropertyValue(ValuePointer) ? 1 : 0) : 
+		KeyProperties[RowIndex]->GetSignedIntPropertyValue(ValuePointer);
+
+	return Tables[TableIndices[RowIndex]].Find(Key);
+}
+
+bool FLiveBlueprintValueFormatter::TryFormat(int32 RowIndex, const void* ValuePointer, FText& OutValueText) const
+{
+	// This only reads the value itself and the tables, so it is safe to call from any thread.
+	if (TableIndices[RowIndex] != INDEX_NONE)
+	{
+		const FText* ValueText = FindTableText(RowIndex, ValuePointer);
+
+		if (ValueText == nullptr)
+		{
+			return false;
+		}
+
+		OutValueText = *ValueText;
+		return true;
+	}
+
+	OutValueText = FText::FromString(
+		CastFieldChecked<FNumericProperty>(Properties[RowIndex])->GetNumericPropertyValueToString(ValuePointer));
+	return true;
+}
+
+FText FLiveBlueprintValueFormatter::FormatProperty(const FProperty* Property, const void* ValuePointer)
+{
+	// This formats the value the same way as the details panel does, which reads display names and
+	// metadata, so it must only be called on the game thread.
+	FFastPropertyInstanceInfo PropertyInstanceInfo{
+		const_cast<void*>(ValuePointer),
+		Property,
+		FFastPropertyInstanceInfo::value_pointer_marker{} };
+
+	return FText::FromString(PropertyInstanceInfo.GetValue().ToString().Replace(TEXT("\n"), TEXT(" ")));
+}
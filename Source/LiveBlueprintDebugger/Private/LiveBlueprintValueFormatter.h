@@ -0,0 +1,139 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+struct FLiveBlueprintRowStore;
+
+// FLiveBlueprintValueFormatter moves the formatting of value text off the game thread.
+//
+// When a cell of a number, enum, or bool row changes, the game thread only copies its value into
+// a staging buffer with Snapshot. Dispatch then formats every snapshot taken since the last batch
+// on a worker thread, and ApplyResults hands the finished text back on a later update, to be set on
+// the value widgets. Other rows can reference strings, containers, or objects that may change or be
+// destroyed while the worker runs, so they are still formatted on the game thread.
+//
+// The worker never touches a UObject, display name, or metadata, none of which are safe to read
+// off the game thread. Numbers are turned into strings directly. The text of every enum value, and
+// of true and false, is looked up in tables that Initialize builds on the game thread by formatting
+// each value the same way as the details panel. A value that is missing from its table, such as an
+// invalid enum value, is not snapshotted and is formatted on the game thread instead. Rows that
+// CanFormat accepts are formatted with FormatOnGameThread everywhere else, so that their text is the
+// same no matter which thread formatted it.
+//
+// There are two staging buffers: one that snapshots are copied into, and one that is being
+// formatted. Both are allocated in Initialize with a fixed slot for every cell, so taking a
+// snapshot never allocates, and a cell that changes several times before the next batch only
+// keeps its latest value. While a batch is being formatted, snapshots keep accumulating and are
+// dispatched once its results have been applied.
+//
+// The worker reads the properties of the class layout, which a Blueprint compile can free. The
+// update driver waits for the batch being formatted with Wait before any Blueprint is compiled,
+// which keeps its results, and a customization whose layout went stale drops them with Cancel.
+class FLiveBlueprintValueFormatter
+{
+public:
+	~FLiveBlueprintValueFormatter();
+
+	void Initialize(const FLiveBlueprintRowStore& Rows);
+
+	bool CanFormat(int32 RowIndex) const;
+	FText FormatOnGameThread(int32 RowIndex, const void* ValuePointer) const;
+
+	// Returns false if the value can't be formatted on a worker thread, in which case it has to be
+	// formatted with FormatOnGameThread right away.
+	bool Snapshot(int32 RowIndex, int32 InstanceIndex, const void* ValuePointer);
+	void Dispatch();
+	void Wait();
+	void Cancel();
+
+	// Calls Functor(CellIndex, ValueText) for every cell of the last batch, once it has been
+	// formatted.
+	template<typename FunctorType>
+	void ApplyResults(FunctorType&& Functor);
+
+	// Waits for the batch being formatted, formats the snapshots that were not dispatched yet on the
+	// calling thread, and calls Functor(CellIndex, ValueText) for all of them.
+	template<typename FunctorType>
+	void Flush(FunctorType&& Functor);
+
+private:
+	struct FBatch
+	{
+		TArray<uint8> Staging;
+		TArray<int32> CellIndices;
+		TArray<FText> ValueTexts;
+	};
+
+	uint8* GetSlotPointer(FBatch& Batch, int32 RowIndex, int32 InstanceIndex) const;
+	void FormatBatch(FBatch& Batch) const;
+	const FText* FindTableText(int32 RowIndex, const void* ValuePointer) const;
+	bool TryFormat(int32 RowIndex, const void* ValuePointer, FText& OutValueText) const;
+	static FText FormatProperty(const FProperty* Property, const void* ValuePointer);
+
+	FBatch Batches[2];
+	int32 SnapshotBatchIndex = 0;
+	TFuture<void> FormattingTask;
+	TBitArray<> IsCellInSnapshotBatch;
+	int32 NumInstances = 1;
+
+	// Indexed by row. SlotOffsets holds the offset of the row's first instance in the staging
+	// buffers, or INDEX_NONE for rows that are formatted on the game thread. Enum and bool rows
+	// read their value with KeyProperties or BoolProperties and look it up in the table at
+	// TableIndices. Plain numbers have no table.
+	TArray<const FProperty*> Properties;
+	TArray<int32> SlotOffsets;
+	TArray<int32> SlotSizes;
+	TArray<int32> SlotStrides;
+	TArray<const FNumericProperty*> KeyProperties;
+	TArray<const FBoolProperty*> BoolProperties;
+	TArray<int32> TableIndices;
+
+	// The text of every value of an enum, or of true and false. Rows of the same enum share a table.
+	TArray<TMap<int64, FText>> Tables;
+};
+
+template<typename FunctorType>
+void FLiveBlueprintValueFormatter::ApplyResults(FunctorType&& Functor)
+{
+	if (!FormattingTask.IsValid() || !FormattingTask.IsReady())
+	{
+		return;
+	}
+
+	FormattingTask = TFuture<void>();
+
+	FBatch& Batch = Batches[SnapshotBatchIndex ^ 1];
+
+	for (int32 Index = 0; Index < Batch.CellIndices.Num(); Index++)
+	{
+		Functor(Batch.CellIndices[Index], Batch.ValueTexts[Index]);
+	}
+
+	Batch.CellIndices.Reset();
+	Batch.ValueTexts.Reset();
+}
+
+template<typename FunctorType>
+void FLiveBlueprintValueFormatter::Flush(FunctorType&& Functor)
+{
+	if (FormattingTask.IsValid())
+	{
+		FormattingTask.Wait();
+		ApplyResults(Functor);
+	}
+
+	FBatch& Batch = Batches[SnapshotBatchIndex];
+	FormatBatch(Batch);
+
+	for (int32 Index = 0; Index < Batch.CellIndices.Num(); Index++)
+	{
+		IsCellInSnapshotBatch[Batch.CellIndices[Index]] = false;
+		Functor(Batch.CellIndices[Index], Batch.ValueTexts[Index]);
+	}
+
+	Batch.CellIndices.Reset();
+	Batch.ValueTexts.Reset();
+}
@@ -0,0 +1,81 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "LiveBlueprintValueHistory.h"
+
+void FLiveBlueprintValueHistory::Initialize(int32 NumSlots, int32 InCapacity)
+{
+	Capacity = FMath::Max(InCapacity, 1);
+	CurrentTime = 0.0;
+
+	FirstSampleIndices.Init(0, NumSlots);
+	SampleCounts.Init(0, NumSlots);
+	SampleTimes.Init(0.0, NumSlots * Capacity);
+	SampleValues.Init(0.0, NumSlots * Capacity);
+}
+
+void FLiveBlueprintValueHistory::AddSample(int32 SlotIndex, double TimeInSeconds, double Value)
+{
+	int32& SampleCount = SampleCounts[SlotIndex];
+	int32& FirstSampleIndex = FirstSampleIndices[SlotIndex];
+
+	if (SampleCount < Capacity)
+	{
+		SampleCount++;
+	}
+	else
+	{
+		// Overwrite the oldest sample.
+		FirstSampleIndex = (FirstSampleIndex + 1) % Capacity;
+	}
+
+	const int32 BufferIndex = GetBufferIndex(SlotIndex, SampleCount - 1);
+	SampleTimes[BufferIndex] = TimeInSeconds;
+	SampleValues[BufferIndex] = Value;
+}
+
+int32 FLiveBlueprintValueHistory::GetNumSamples(int32 SlotIndex) const
+{
+	return SampleCounts[SlotIndex];
+}
+
+double FLiveBlueprintValueHistory::GetSampleTime(int32 SlotIndex, int32 SampleIndex) const
+{
+	return SampleTimes[GetBufferIndex(SlotIndex, SampleIndex)];
+}
+
+double FLiveBlueprintValueHistory::GetSampleValue(int32 SlotIndex, int32 SampleIndex) const
+{
+	return SampleValues[GetBufferIndex(SlotIndex, SampleIndex)];
+}
+
+double FLiveBlueprintValueHistory::GetCurrentTime() const
+{
+	return CurrentTime;
+}
+
+void FLiveBlueprintValueHistory::SetCurrentTime(double TimeInSeconds)
+{
+	CurrentTime = TimeInSeconds;
+}
+
+SIZE_T FLiveBlueprintValueHistory::GetAllocatedSize() const
+{
+	return (
+		FirstSampleIndices.GetAllocatedSize() +
+		SampleCounts.GetAllocatedSize() +
+		SampleTimes.GetAllocatedSize() +
+		SampleValues.GetAllocatedSize());
+}
+
+bool FLiveBlueprintValueHistory::IsNumericProperty(const FProperty* Property)
+{
+	return (
+		Property->IsA<FNumericProperty>() ||
+		Property->IsA<FEnumProperty>() ||
+		Property->IsA<FBoolProperty>());
+}
+
+int32 FLiveBlueprintValueHistory::GetBufferIndex(int32 SlotIndex, int32 SampleIndex) const
+{
+	return SlotIndex * Capacity + (FirstSampleIndices[SlotIndex] + SampleIndex) % Capacity;
+}
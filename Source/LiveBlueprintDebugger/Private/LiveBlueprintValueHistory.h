@@ -0,0 +1,50 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// FLiveBlueprintValueHistory records the recent values of numeric, enum, and bool variables so they
+// can be drawn as sparklines.
+//
+// Every watched value gets a slot, and every slot is a fixed-size ring buffer of (time, value)
+// samples. All slots share two arrays that are allocated once in Initialize, so recording a sample
+// never allocates and the memory used is bounded by NumSlots * Capacity no matter how long the
+// play session runs. Once a slot is full, the oldest sample is overwritten.
+//
+// Samples are only recorded when a value changes, so the history is a step function: each value
+// holds until the time of the next sample.
+class FLiveBlueprintValueHistory
+{
+public:
+	void Initialize(int32 NumSlots, int32 Capacity);
+
+	void AddSample(int32 SlotIndex, double TimeInSeconds, double Value);
+	int32 GetNumSamples(int32 SlotIndex) const;
+
+	// Samples are indexed from oldest (0) to newest (GetNumSamples - 1).
+	double GetSampleTime(int32 SlotIndex, int32 SampleIndex) const;
+	double GetSampleValue(int32 SlotIndex, int32 SampleIndex) const;
+
+	// The time the history was last updated, which is where sparklines end.
+	double GetCurrentTime() const;
+	void SetCurrentTime(double TimeInSeconds);
+
+	SIZE_T GetAllocatedSize() const;
+
+	static bool IsNumericProperty(const FProperty* Property);
+
+private:
+	int32 GetBufferIndex(int32 SlotIndex, int32 SampleIndex) const;
+
+	int32 Capacity = 0;
+	double CurrentTime = 0.0;
+
+	// Indexed by slot.
+	TArray<int32> FirstSampleIndices;
+	TArray<int32> SampleCounts;
+
+	// Indexed by slot * Capacity + ring buffer position.
+	TArray<double> SampleTimes;
+	TArray<double> SampleValues;
+};
@@ -0,0 +1,265 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "PropertyValueHasher.h"
+
+#include "Hash/CityHash.h"
+
+uint32 FPropertyValueHasher::HashValue(const FProperty* Property, const void* ValuePointer)
+{
+	if (Property == nullptr)
+	{
+		return 0;
+	}
+
+	return HashValue(GetValueKind(Property), Property, ValuePointer);
+}
+
+uint32 FPropertyValueHasher::HashValue(EPropertyValueKind ValueKind, const FProperty* Property, const void* ValuePointer)
+{
+	if (Property == nullptr || ValuePointer == nullptr)
+	{
+		return 0;
+	}
+
+	switch (ValueKind)
+	{
+		case EPropertyValueKind::PlainOldData:
+		{
+			return HashBytes(ValuePointer, Property->GetSize());
+		}
+
+		case EPropertyValueKind::Bool:
+		{
+			// Bool properties may be bitfields that share a byte with other bools, so only the
+			// property's own bit can be considered.
+			return static_cast<const FBoolProperty*>(Property)->GetPropertyValue(ValuePointer) ? 1 : 0;
+		}
+
+		case EPropertyValueKind::Name:
+		{
+			return GetTypeHash(*static_cast<const FName*>(ValuePointer));
+		}
+
+		case EPropertyValueKind::String:
+		{
+			return HashString(*static_cast<const FString*>(ValuePointer));
+		}
+
+		case EPropertyValueKind::Text:
+		{
+			return HashString(static_cast<const FText*>(ValuePointer)->ToString());
+		}
+
+		case EPropertyValueKind::Object:
+		{
+			// The details panel shows the name of the referenced object, so hashing its address is
+			// enough to detect when the reference changes.
+			const UObject* Object = static_cast<const FObjectPropertyBase*>(Property)->GetObjectPropertyValue(ValuePointer);
+			return HashBytes(&Object, sizeof(Object));
+		}
+
+		case EPropertyValueKind::Interface:
+		{
+			const UObject* Object = static_cast<const FScriptInterface*>(ValuePointer)->GetObject();
+			return HashBytes(&Object, sizeof(Object));
+		}
+
+		case EPropertyValueKind::Struct:
+		{
+			return HashStruct(static_cast<const FStructProperty*>(Property), ValuePointer);
+		}
+
+		case EPropertyValueKind::Array:
+		{
+			return HashArray(static_cast<const FArrayProperty*>(Property), ValuePointer);
+		}
+
+		case EPropertyValueKind::Map:
+		{
+			return HashMap(static_cast<const FMapProperty*>(Property), ValuePointer);
+		}
+
+		case EPropertyValueKind::Set:
+		{
+			return HashSet(static_cast<const FSetProperty*>(Property), ValuePointer);
+		}
+
+		default:
+		case EPropertyValueKind::Other:
+		{
+			// Anything else (delegates, field paths, etc.) is rare enough in Blueprint variables that
+			// we can afford to hash its exported text.
+			FString ValueString;
+			Property->ExportText_Direct(ValueString, ValuePointer, nullptr, nullptr, PPF_None);
+			return HashString(ValueString);
+		}
+	}
+}
+
+EPropertyValueKind FPropertyValueHasher::GetValueKind(const FProperty* Property)
+{
+	if (IsPlainOldData(Property))
+	{
+		return EPropertyValueKind::PlainOldData;
+	}
+	else if (Property->IsA<FBoolProperty>())
+	{
+		return EPropertyValueKind::Bool;
+	}
+	else if (Property->IsA<FNameProperty>())
+	{
+		return EPropertyValueKind::Name;
+	}
+	else if (Property->IsA<FStrProperty>())
+	{
+		return EPropertyValueKind::String;
+	}
+	else if (Property->IsA<FTextProperty>())
+	{
+		return EPropertyValueKind::Text;
+	}
+	else if (Property->IsA<FObjectPropertyBase>())
+	{
+		return EPropertyValueKind::Object;
+	}
+	else if (Property->IsA<FInterfaceProperty>())
+	{
+		return EPropertyValueKind::Interface;
+	}
+	else if (Property->IsA<FStructProperty>())
+	{
+		return EPropertyValueKind::Struct;
+	}
+	else if (Property->IsA<FArrayProperty>())
+	{
+		return EPropertyValueKind::Array;
+	}
+	else if (Property->IsA<FMapProperty>())
+	{
+		return EPropertyValueKind::Map;
+	}
+	else if (Property->IsA<FSetProperty>())
+	{
+		return EPropertyValueKind::Set;
+	}
+
+	return EPropertyValueKind::Other;
+}
+
+bool FPropertyValueHasher::IsPlainOldData(const FProperty* Property)
+{
+	if (Property->IsA<FBoolProperty>())
+	{
+		return false;
+	}
+	else if (Property->IsA<FNumericProperty>() || Property->IsA<FEnumProperty>())
+	{
+		return true;
+	}
+	else if (auto StructProperty = CastField<FStructProperty>(Property); StructProperty != nullptr)
+	{
+		return (StructProperty->Struct->StructFlags & STRUCT_IsPlainOldData) != 0;
+	}
+
+	return false;
+}
+
+uint32 FPropertyValueHasher::CombineHashes(uint32 A, uint32 B)
+{
+#if ENGINE_MAJOR_VERSION == 4
+	return HashCombine(A, B);
+#else
+	return HashCombineFast(A, B);
+#endif
+}
+
+uint32 FPropertyValueHasher::HashBytes(const void* Data, int32 Size)
+{
+	return CityHash32(static_cast<const char*>(Data), static_cast<uint32>(Size));
+}
+
+uint32 FPropertyValueHasher::HashString(const FString& String)
+{
+	// GetTypeHash(FString) is case insensitive, which would hide changes in capitalization.
+	return HashBytes(*String, String.Len() * sizeof(TCHAR));
+}
+
+uint32 FPropertyValueHasher::HashStruct(const FStructProperty* StructProperty, const void* ValuePointer)
+{
+	uint32 ValueHash = 0;
+
+	for (TFieldIterator<FProperty> It(StructProperty->Struct); It; ++It)
+	{
+		ValueHash = CombineHashes(
+			ValueHash,
+			HashValue(*It, It->ContainerPtrToValuePtr<void>(ValuePointer)));
+	}
+
+	return ValueHash;
+}
+
+uint32 FPropertyValueHasher::HashArray(const FArrayProperty* ArrayProperty, const void* ValuePointer)
+{
+	FScriptArrayHelper ArrayHelper{ ArrayProperty, ValuePointer };
+
+	// Seed the hash with the number of elements so that the hash changes if elements are added or
+	// removed, even if they happen to hash to the same value.
+	uint32 ValueHash = ArrayHelper.Num();
+
+	if (ArrayHelper.Num() == 0)
+	{
+		return ValueHash;
+	}
+
+	if (IsPlainOldData(ArrayProperty->Inner))
+	{
+		// Array elements are stored contiguously, so arrays of POD elements can be hashed in a
+		// single pass.
+		return CombineHashes(
+			ValueHash,
+			HashBytes(ArrayHelper.GetRawPtr(0), ArrayHelper.Num() * ArrayProperty->Inner->GetSize()));
+	}
+
+	for (int32 i = 0; i < ArrayHelper.Num(); i++)
+	{
+		ValueHash = CombineHashes(
+			ValueHash,
+			HashValue(ArrayProperty->Inner, ArrayHelper.GetRawPtr(i)));
+	}
+
+	return ValueHash;
+}
+
+uint32 FPropertyValueHasher::HashMap(const FMapProperty* MapProperty, const void* ValuePointer)
+{
+	FScriptMapHelper MapHelper{ MapProperty, ValuePointer };
+	uint32 ValueHash = MapHelper.Num();
+
+	// Map storage is sparse, so we need to skip over any unused indices.
+	for (int32 i = 0; i < MapHelper.GetMaxIndex(); i++)
+	{
+		if (MapHelper.IsValidIndex(i))
+		{
+			ValueHash = CombineHashes(ValueHash, HashValue(MapHelper.GetKeyProperty(), MapHelper.GetKeyPtr(i)));
+			ValueHash = CombineHashes(ValueHash, HashValue(MapHelper.GetValueProperty(), MapHelper.GetValuePtr(i)));
+		}
+	}
+
+	return ValueHash;
+}
+
+uint32 FPropertyValueHasher::HashSet(const FSetProperty* SetProperty, const void* ValuePointer)
+{
+	FScriptSetHelper SetHelper{ SetProperty, ValuePointer };
+	uint32 ValueHash = SetHelper.Num();
+
+	for (int32 i = 0; i < SetHelper.GetMaxIndex(); i++)
+	{
+		if (SetHelper.IsValidIndex(i))
+		{
+			ValueHash = CombineHashes(ValueHash, HashValue(SetHelper.GetElementProperty(), SetHelper.GetElementPtr(i)));
+		}
+	}
+
+	return ValueHash;
+}
@@ -0,0 +1,49 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// The kind of value a property holds, which determines how it is hashed. This is resolved once per
+// property so that hashing a row does not need to query the reflection system every tick.
+enum class EPropertyValueKind : uint8
+{
+	PlainOldData,
+	Bool,
+	Name,
+	String,
+	Text,
+	Object,
+	Interface,
+	Struct,
+	Array,
+	Map,
+	Set,
+	Other
+};
+
+// FPropertyValueHasher computes change-detection hashes directly from the memory of a property
+// value. Plain-old-data values (numbers, enums, and structs that the reflection system marks as
+// POD) are hashed byte-for-byte. Only types that own memory elsewhere or need special handling
+// (bools, names, strings, text, object references, containers, and non-POD structs) fall back to
+// hashing their logical contents.
+//
+// Because no value text is ever generated, hashing is cheap enough to run every refresh tick and
+// always reflects the live value rather than the text that was last shown in the details panel.
+class FPropertyValueHasher
+{
+public:
+	static uint32 HashValue(const FProperty* Property, const void* ValuePointer);
+	static uint32 HashValue(EPropertyValueKind ValueKind, const FProperty* Property, const void* ValuePointer);
+	static EPropertyValueKind GetValueKind(const FProperty* Property);
+	static bool IsPlainOldData(const FProperty* Property);
+	static uint32 CombineHashes(uint32 A, uint32 B);
+
+private:
+	static uint32 HashBytes(const void* Data, int32 Size);
+	static uint32 HashString(const FString& String);
+	static uint32 HashStruct(const FStructProperty* StructProperty, const void* ValuePointer);
+	static uint32 HashArray(const FArrayProperty* ArrayProperty, const void* ValuePointer);
+	static uint32 HashMap(const FMapProperty* MapProperty, const void* ValuePointer);
+	static uint32 HashSet(const FSetProperty* SetProperty, const void* ValuePointer);
+};
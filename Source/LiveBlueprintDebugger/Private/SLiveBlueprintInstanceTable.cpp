@@ -0,0 +1,455 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "SLiveBlueprintInstanceTable.h"
+
+#include "Editor.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "EngineUtils.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
+#include "LiveBlueprintDebuggerSettings.h"
+#include "Selection.h"
+#include "Widgets/Input/SComboButton.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/STableRow.h"
+
+#define LOCTEXT_NAMESPACE "FLiveBlueprintDebuggerModule"
+
+const FName SLiveBlueprintInstanceTable::TabName = "LiveBlueprintInstances";
+
+static const FName c_InstanceColumnId = "Instance";
+
+// Sorting and filtering move rows around, so they are reapplied at most this often while values
+// are changing to keep the table readable.
+static constexpr double c_ReorderPeriodInSeconds = 0.25;
+
+class SLiveBlueprintInstanceTableRow : public SMultiColumnTableRow<TSharedPtr<FLiveBlueprintInstanceTableItem>>
+{
+public:
+	SLATE_BEGIN_ARGS(SLiveBlueprintInstanceTableRow) {}
+	SLATE_END_ARGS()
+
+	void Construct(
+		const FArguments& InArgs,
+		const TSharedRef<STableViewBase>& OwnerTable,
+		const TSharedRef<FLiveBlueprintInstanceTable>& InTable,
+		const TSharedPtr<FLiveBlueprintInstanceTableItem>& InItem,
+		TFunction<int32(const FName&)> InGetColumnIndex)
+	{
+		Table = InTable;
+		Item = InItem;
+		GetColumnIndex = MoveTemp(InGetColumnIndex);
+
+		SMultiColumnTableRow<TSharedPtr<FLiveBlueprintInstanceTableItem>>::Construct(
+			FSuperRowType::FArguments(),
+			OwnerTable);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnId) override
+	{
+		const int32 ColumnIndex = GetColumnIndex(ColumnId);
+
+		// The text is read from the table every time the row is painted, so rows never need to be
+		// regenerated when values change.
+		auto GetCellText = [WeakTable = TWeakPtr<FLiveBlueprintInstanceTable>(Table), WeakItem = TWeakPtr<FLiveBlueprintInstanceTableItem>(Item), ColumnIndex]()
+		{
+			TSharedPtr<FLiveBlueprintInstanceTable> PinnedTable = WeakTable.Pin();
+			TSharedPtr<FLiveBlueprintInstanceTableItem> PinnedItem = WeakItem.Pin();
+
+			if (!PinnedTable.IsValid() ||
+				!PinnedItem.IsValid() ||
+				PinnedItem->InstanceIndex >= PinnedTable->NumInstances() ||
+				ColumnIndex >= PinnedTable->NumColumns())
+			{
+				return FText::GetEmpty();
+			}
+
+			return FText::FromString(
+				(ColumnIndex == INDEX_NONE) ?
+					PinnedTable->GetInstanceName(PinnedItem->InstanceIndex) :
+					PinnedTable->GetCellText(PinnedItem->InstanceIndex, ColumnIndex));
+		};
+
+		return SNew(STextBlock)
+			.Text(TAttribute<FText>::Create(TAttribute<FText>::FGetter::CreateLambda(GetCellText)))
+			.ToolTipText(TAttribute<FText>::Create(TAttribute<FText>::FGetter::CreateLambda(GetCellText)));
+	}
+
+private:
+	TSharedPtr<FLiveBlueprintInstanceTable> Table;
+	TSharedPtr<FLiveBlueprintInstanceTableItem> Item;
+	TFunction<int32(const FName&)> GetColumnIndex;
+};
+
+void SLiveBlueprintInstanceTable::Construct(const FArguments& InArgs)
+{
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(2.f)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SComboButton)
+				.OnGetMenuContent(this, &SLiveBlueprintInstanceTable::GetClassMenuContent)
+				.ToolTipText(LOCTEXT("ChooseClassToolTip", "Choose the Blueprint class whose instances are shown."))
+				.ButtonContent()
+				[
+					SNew(STextBlock)
+					.Text(this, &SLiveBlueprintInstanceTable::GetClassText)
+				]
+			]
+
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.f)
+			.Padding(4.f, 0.f)
+			[
+				SNew(SSearchBox)
+				.HintText(LOCTEXT("FilterHint", "Filter instances..."))
+				.OnTextChanged(this, &SLiveBlueprintInstanceTable::OnFilterTextChanged)
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SComboButton)
+				.OnGetMenuContent(this, &SLiveBlueprintInstanceTable::GetFilterColumnMenuContent)
+				.ToolTipText(LOCTEXT("FilterColumnToolTip", "Choose which column the filter applies to."))
+				.ButtonContent()
+				[
+					SNew(STextBlock)
+					.Text(this, &SLiveBlueprintInstanceTable::GetFilterColumnText)
+				]
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(8.f, 0.f, 4.f, 0.f)
+			[
+				SNew(STextBlock)
+				.Text(this, &SLiveBlueprintInstanceTable::GetStatusText)
+			]
+		]
+
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		[
+			SAssignNew(ListView, SListView<FItemPtr>)
+			.ListItemsSource(&Items)
+			.SelectionMode(ESelectionMode::Single)
+			.OnGenerateRow(this, &SLiveBlueprintInstanceTable::OnGenerateRow)
+			.OnMouseButtonDoubleClick(this, &SLiveBlueprintInstanceTable::OnRowDoubleClicked)
+			.HeaderRow(SAssignNew(HeaderRow, SHeaderRow))
+		]
+	];
+
+	// Start with the class of the selected actor, if it is a Blueprint instance that is playing.
+	UClass* InitialClass = nullptr;
+
+	if (GEditor->PlayWorld != nullptr)
+	{
+		for (FSelectionIterator It(*GEditor->GetSelectedActors()); It; ++It)
+		{
+			AActor* SelectedActor = Cast<AActor>(*It);
+
+			if (SelectedActor != nullptr &&
+				SelectedActor->GetWorld() == GEditor->PlayWorld &&
+				Cast<UBlueprintGeneratedClass>(SelectedActor->GetClass()) != nullptr)
+			{
+				InitialClass = SelectedActor->GetClass();
+				break;
+			}
+		}
+	}
+
+	SetClass(InitialClass);
+}
+
+void SLiveBlueprintInstanceTable::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	// Start over whenever a play session starts or ends, or the class is recompiled.
+	if (Table->GetWorld() != GEditor->PlayWorld || Table->IsStale())
+	{
+		SetClass(Table->GetClass());
+	}
+
+	if (InCurrentTime >= NextInstanceScanTime)
+	{
+		NextInstanceScanTime = InCurrentTime + FLiveBlueprintInstanceTable::InstanceScanPeriodInSeconds;
+
+		if (Table->ScanInstances())
+		{
+			RebuildItems();
+		}
+	}
+
+	// Only changes to the sorted column, or to any column while filtering, affect the order of rows.
+	const bool bIsFiltering = !FilterText.IsEmpty();
+	const int32 SortColumnIndex = GetColumnIndex(SortColumnId);
+	const bool bIsSortingByValue = (SortMode != EColumnSortMode::None && SortColumnIndex != INDEX_NONE);
+	const double BudgetInSeconds = GetDefault<ULiveBlueprintDebuggerSettings>()->UpdateBudgetMicroseconds / 1'000'000.0;
+
+	if (Table->Tick(BudgetInSeconds, bIsFiltering ? INDEX_NONE : SortColumnIndex) &&
+		(bIsFiltering || bIsSortingByValue))
+	{
+		bNeedsReorder = true;
+	}
+
+	if (bNeedsReorder && InCurrentTime >= NextReorderTime)
+	{
+		NextReorderTime = InCurrentTime + c_ReorderPeriodInSeconds;
+		bNeedsReorder = false;
+
+		if (bIsFiltering)
+		{
+			RebuildItems();
+		}
+		else
+		{
+			SortItems();
+			ListView->RequestListRefresh();
+		}
+	}
+}
+
+void SLiveBlueprintInstanceTable::SetClass(TWeakObjectPtr<UClass> Class)
+{
+	Table->Reset(GEditor->PlayWorld, Class.Get());
+	FilterColumnIndex = INDEX_NONE;
+	SortColumnId = NAME_None;
+	SortMode = EColumnSortMode::None;
+	NextInstanceScanTime = 0.0;
+	bNeedsReorder = false;
+
+	RebuildColumns();
+	RebuildItems();
+}
+
+void SLiveBlueprintInstanceTable::RebuildColumns()
+{
+	HeaderRow->ClearColumns();
+
+	auto AddColumn = [this](const FName& ColumnId, const FText& Label, float FillWidth)
+	{
+		HeaderRow->AddColumn(
+			SHeaderRow::Column(ColumnId)
+			.DefaultLabel(Label)
+			.FillWidth(FillWidth)
+			.SortMode(TAttribute<EColumnSortMode::Type>::Create(
+				TAttribute<EColumnSortMode::Type>::FGetter::CreateSP(this, &SLiveBlueprintInstanceTable::GetColumnSortMode, ColumnId)))
+			.OnSort(this, &SLiveBlueprintInstanceTable::OnSortModeChanged));
+	};
+
+	AddColumn(c_InstanceColumnId, LOCTEXT("InstanceColumn", "Instance"), 1.5f);
+
+	for (int32 ColumnIndex = 0; ColumnIndex < Table->NumColumns(); ColumnIndex++)
+	{
+		AddColumn(GetColumnId(ColumnIndex), Table->GetColumnName(ColumnIndex), 1.f);
+	}
+
+	ListView->RebuildList();
+}
+
+void SLiveBlueprintInstanceTable::RebuildItems()
+{
+	Items.Reset();
+
+	for (int32 InstanceIndex = 0; InstanceIndex < Table->NumInstances(); InstanceIndex++)
+	{
+		if (FilterText.IsEmpty() || Table->MatchesFilter(InstanceIndex, FilterColumnIndex, FilterText))
+		{
+			FItemPtr Item = MakeShared<FLiveBlueprintInstanceTableItem>();
+			Item->InstanceIndex = InstanceIndex;
+			Items.Add(Item);
+		}
+	}
+
+	SortItems();
+	ListView->RequestListRefresh();
+}
+
+void SLiveBlueprintInstanceTable::SortItems()
+{
+	if (SortMode == EColumnSortMode::None)
+	{
+		return;
+	}
+
+	const int32 SortColumnIndex = GetColumnIndex(SortColumnId);
+	const bool bAscending = (SortMode == EColumnSortMode::Ascending);
+
+	Items.StableSort(
+		[this, SortColumnIndex, bAscending](const FItemPtr& A, const FItemPtr& B)
+		{
+			return bAscending ?
+				Table->IsLess(A->InstanceIndex, B->InstanceIndex, SortColumnIndex) :
+				Table->IsLess(B->InstanceIndex, A->InstanceIndex, SortColumnIndex);
+		});
+}
+
+int32 SLiveBlueprintInstanceTable::GetColumnIndex(const FName& ColumnId)
+{
+	if (ColumnId == c_InstanceColumnId || ColumnId.IsNone())
+	{
+		return INDEX_NONE;
+	}
+
+	return ColumnId.GetNumber() - 1;
+}
+
+FName SLiveBlueprintInstanceTable::GetColumnId(int32 ColumnIndex)
+{
+	// Variable names can't be used as column IDs since a variable could be named "Instance", so the
+	// column index is stored in the number of the name instead.
+	return FName(TEXT("Variable"), ColumnIndex + 1);
+}
+
+TSharedRef<SWidget> SLiveBlueprintInstanceTable::GetClassMenuContent()
+{
+	FMenuBuilder MenuBuilder(true, nullptr);
+	UWorld* PlayWorld = GEditor->PlayWorld;
+
+	if (PlayWorld == nullptr)
+	{
+		MenuBuilder.AddMenuEntry(
+			LOCTEXT("NotPlaying", "Start playing in the editor to see Blueprint instances."),
+			FText::GetEmpty(),
+			FSlateIcon(),
+			FUIAction(FExecuteAction(), FCanExecuteAction::CreateLambda([]() { return false; })));
+
+		return MenuBuilder.MakeWidget();
+	}
+
+	TMap<UClass*, int32> NumInstancesByClass;
+
+	for (TActorIterator<AActor> It(PlayWorld); It; ++It)
+	{
+		if (Cast<UBlueprintGeneratedClass>(It->GetClass()) != nullptr)
+		{
+			NumInstancesByClass.FindOrAdd(It->GetClass())++;
+		}
+	}
+
+	NumInstancesByClass.KeySort(
+		[](const UClass& A, const UClass& B)
+		{
+			return A.GetName() < B.GetName();
+		});
+
+	for (const auto& [Class, NumInstances] : NumInstancesByClass)
+	{
+		MenuBuilder.AddMenuEntry(
+			FText::Format(LOCTEXT("ClassEntry", "{0} ({1})"), Class->GetDisplayNameText(), NumInstances),
+			FText::GetEmpty(),
+			FSlateIcon(),
+			FUIAction(FExecuteAction::CreateSP(this, &SLiveBlueprintInstanceTable::SetClass, TWeakObjectPtr<UClass>(Class))));
+	}
+
+	return MenuBuilder.MakeWidget();
+}
+
+TSharedRef<SWidget> SLiveBlueprintInstanceTable::GetFilterColumnMenuContent()
+{
+	FMenuBuilder MenuBuilder(true, nullptr);
+
+	auto AddEntry = [this, &MenuBuilder](const FText& Label, int32 ColumnIndex)
+	{
+		MenuBuilder.AddMenuEntry(
+			Label,
+			FText::GetEmpty(),
+			FSlateIcon(),
+			FUIAction(FExecuteAction::CreateSP(this, &SLiveBlueprintInstanceTable::SetFilterColumn, ColumnIndex)));
+	};
+
+	AddEntry(LOCTEXT("AllColumns", "All Columns"), INDEX_NONE);
+
+	for (int32 ColumnIndex = 0; ColumnIndex < Table->NumColumns(); ColumnIndex++)
+	{
+		AddEntry(Table->GetColumnName(ColumnIndex), ColumnIndex);
+	}
+
+	return MenuBuilder.MakeWidget();
+}
+
+FText SLiveBlueprintInstanceTable::GetClassText() const
+{
+	UClass* Class = Table->GetClass();
+
+	return (Class != nullptr) ?
+		Class->GetDisplayNameText() :
+		LOCTEXT("NoClass", "Choose a Blueprint class");
+}
+
+FText SLiveBlueprintInstanceTable::GetFilterColumnText() const
+{
+	return (FilterColumnIndex != INDEX_NONE && FilterColumnIndex < Table->NumColumns()) ?
+		Table->GetColumnName(FilterColumnIndex) :
+		LOCTEXT("AllColumns", "All Columns");
+}
+
+FText SLiveBlueprintInstanceTable::GetStatusText() const
+{
+	return FText::Format(
+		LOCTEXT("Status", "{0} of {1} instances"),
+		Items.Num(),
+		Table->NumInstances());
+}
+
+void SLiveBlueprintInstanceTable::SetFilterColumn(int32 ColumnIndex)
+{
+	FilterColumnIndex = ColumnIndex;
+	RebuildItems();
+}
+
+void SLiveBlueprintInstanceTable::OnFilterTextChanged(const FText& Text)
+{
+	FilterText = Text.ToString();
+	RebuildItems();
+}
+
+void SLiveBlueprintInstanceTable::OnSortModeChanged(
+	EColumnSortPriority::Type Priority,
+	const FName& ColumnId,
+	EColumnSortMode::Type NewSortMode)
+{
+	SortColumnId = ColumnId;
+	SortMode = NewSortMode;
+	SortItems();
+	ListView->RequestListRefresh();
+}
+
+EColumnSortMode::Type SLiveBlueprintInstanceTable::GetColumnSortMode(FName ColumnId) const
+{
+	return (ColumnId == SortColumnId) ? SortMode : EColumnSortMode::None;
+}
+
+TSharedRef<ITableRow> SLiveBlueprintInstanceTable::OnGenerateRow(FItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SLiveBlueprintInstanceTableRow, OwnerTable, Table, Item, &SLiveBlueprintInstanceTable::GetColumnIndex);
+}
+
+void SLiveBlueprintInstanceTable::OnRowDoubleClicked(FItemPtr Item)
+{
+	if (!Item.IsValid() || Item->InstanceIndex >= Table->NumInstances())
+	{
+		return;
+	}
+
+	if (AActor* Instance = Table->GetInstance(Item->InstanceIndex); Instance != nullptr)
+	{
+		GEditor->SelectNone(false, true);
+		GEditor->SelectActor(Instance, true, true);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
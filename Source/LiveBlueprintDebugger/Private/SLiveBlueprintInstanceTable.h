@@ -0,0 +1,75 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/SListView.h"
+
+#include "LiveBlueprintInstanceTable.h"
+
+class ITableRow;
+class STableViewBase;
+
+// One row of the instance table. Rows refer to instances by index, so the list of rows is rebuilt
+// whenever instances are added or removed.
+struct FLiveBlueprintInstanceTableItem
+{
+	int32 InstanceIndex = INDEX_NONE;
+};
+
+// SLiveBlueprintInstanceTable is the content of the "Live Blueprint Instances" tab. It shows every
+// instance of a chosen Blueprint class in the play-in-editor world as a spreadsheet, with one
+// column per top-level Blueprint variable. Columns can be sorted by clicking their header, and rows
+// can be filtered by text in any column or in one chosen column. Double-clicking a row selects the
+// instance in the editor.
+//
+// The table is only updated while the widget is ticked, which Slate only does while the tab is
+// visible, and the update is limited to the same per-frame budget as the details panel.
+class SLiveBlueprintInstanceTable : public SCompoundWidget
+{
+public:
+	static const FName TabName;
+
+	SLATE_BEGIN_ARGS(SLiveBlueprintInstanceTable) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
+private:
+	using FItemPtr = TSharedPtr<FLiveBlueprintInstanceTableItem>;
+
+	void SetClass(TWeakObjectPtr<UClass> Class);
+	void SetFilterColumn(int32 ColumnIndex);
+	void RebuildColumns();
+	void RebuildItems();
+	void SortItems();
+	static int32 GetColumnIndex(const FName& ColumnId);
+	static FName GetColumnId(int32 ColumnIndex);
+
+	TSharedRef<SWidget> GetClassMenuContent();
+	TSharedRef<SWidget> GetFilterColumnMenuContent();
+	FText GetClassText() const;
+	FText GetFilterColumnText() const;
+	FText GetStatusText() const;
+	void OnFilterTextChanged(const FText& Text);
+	void OnSortModeChanged(EColumnSortPriority::Type Priority, const FName& ColumnId, EColumnSortMode::Type SortMode);
+	EColumnSortMode::Type GetColumnSortMode(FName ColumnId) const;
+	TSharedRef<ITableRow> OnGenerateRow(FItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnRowDoubleClicked(FItemPtr Item);
+
+	TSharedRef<FLiveBlueprintInstanceTable> Table = MakeShared<FLiveBlueprintInstanceTable>();
+	TArray<FItemPtr> Items;
+	TSharedPtr<SListView<FItemPtr>> ListView;
+	TSharedPtr<SHeaderRow> HeaderRow;
+	FString FilterText;
+	int32 FilterColumnIndex = INDEX_NONE;
+	FName SortColumnId;
+	EColumnSortMode::Type SortMode = EColumnSortMode::None;
+	double NextInstanceScanTime = 0.0;
+	double NextReorderTime = 0.0;
+	bool bNeedsReorder = false;
+};
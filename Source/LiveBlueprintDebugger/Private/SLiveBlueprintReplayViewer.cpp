@@ -0,0 +1,366 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "SLiveBlueprintReplayViewer.h"
+
+#include "DesktopPlatformModule.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
+#include "IDesktopPlatform.h"
+#include "LiveBlueprintRecordingFormat.h"
+#include "Misc/Paths.h"
+#include "Styling/CoreStyle.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SComboButton.h"
+#include "Widgets/Input/SSlider.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/STableRow.h"
+
+#define LOCTEXT_NAMESPACE "FLiveBlueprintDebuggerModule"
+
+const FName SLiveBlueprintReplayViewer::TabName = "LiveBlueprintReplay";
+
+static const FName c_NameColumnId = "Name";
+static const FName c_ValueColumnId = "Value";
+
+class SLiveBlueprintReplayRow : public SMultiColumnTableRow<TSharedPtr<FLiveBlueprintReplayItem>>
+{
+public:
+	SLATE_BEGIN_ARGS(SLiveBlueprintReplayRow) {}
+	SLATE_END_ARGS()
+
+	void Construct(
+		const FArguments& InArgs,
+		const TSharedRef<STableViewBase>& OwnerTable,
+		const TSharedPtr<FLiveBlueprintReplayItem>& InItem)
+	{
+		Item = InItem;
+
+		SMultiColumnTableRow<TSharedPtr<FLiveBlueprintReplayItem>>::Construct(
+			FSuperRowType::FArguments(),
+			OwnerTable);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnId) override
+	{
+		const bool bIsCategory = (Item->RowIndex == INDEX_NONE);
+
+		if (ColumnId == c_NameColumnId)
+		{
+			TSharedRef<STextBlock> NameText = SNew(STextBlock)
+				.Text(Item->Name)
+				.ToolTipText(Item->TypeText);
+
+			if (bIsCategory)
+			{
+				NameText->SetFont(FCoreStyle::GetDefaultFontStyle("Bold", 9));
+			}
+
+			return SNew(SBox)
+				.Padding(FMargin(Item->Depth * 12.f, 0.f, 0.f, 0.f))
+				[
+					NameText
+				];
+		}
+
+		if (bIsCategory)
+		{
+			return SNullWidget::NullWidget;
+		}
+
+		// The text is read from the item every time the row is painted, so rows never need to be
+		// regenerated when the timeline moves.
+		auto GetValueText = [WeakItem = TWeakPtr<FLiveBlueprintReplayItem>(Item)]()
+		{
+			TSharedPtr<FLiveBlueprintReplayItem> PinnedItem = WeakItem.Pin();
+			return PinnedItem.IsValid() ? PinnedItem->ValueText : FText::GetEmpty();
+		};
+
+		return SNew(STextBlock)
+			.Text(TAttribute<FText>::Create(TAttribute<FText>::FGetter::CreateLambda(GetValueText)))
+			.ToolTipText(TAttribute<FText>::Create(TAttribute<FText>::FGetter::CreateLambda(GetValueText)));
+	}
+
+private:
+	TSharedPtr<FLiveBlueprintReplayItem> Item;
+};
+
+void SLiveBlueprintReplayViewer::Construct(const FArguments& InArgs)
+{
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(2.f)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("OpenRecording", "Open Recording..."))
+				.ToolTipText(LOCTEXT("OpenRecordingToolTip", "Open a recording made with LiveBlueprintDebugger.StartRecording."))
+				.OnClicked(this, &SLiveBlueprintReplayViewer::OnOpenClicked)
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(4.f, 0.f)
+			[
+				SNew(SComboButton)
+				.OnGetMenuContent(this, &SLiveBlueprintReplayViewer::GetInstanceMenuContent)
+				.ToolTipText(LOCTEXT("ChooseRecordedActorToolTip", "Choose which recorded Actor to show."))
+				.ButtonContent()
+				[
+					SNew(STextBlock)
+					.Text(this, &SLiveBlueprintReplayViewer::GetInstanceText)
+				]
+			]
+
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.f)
+			.VAlign(VAlign_Center)
+			.Padding(8.f, 0.f, 4.f, 0.f)
+			[
+				SNew(STextBlock)
+				.Text(this, &SLiveBlueprintReplayViewer::GetStatusText)
+			]
+		]
+
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(2.f)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.f)
+			.VAlign(VAlign_Center)
+			[
+				SNew(SSlider)
+				.Value(this, &SLiveBlueprintReplayViewer::GetTimelinePosition)
+				.OnValueChanged(this, &SLiveBlueprintReplayViewer::OnTimelinePositionChanged)
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(8.f, 0.f, 4.f, 0.f)
+			[
+				SNew(STextBlock)
+				.Text(this, &SLiveBlueprintReplayViewer::GetTimeText)
+			]
+		]
+
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		[
+			SAssignNew(ListView, SListView<FItemPtr>)
+			.ListItemsSource(&Items)
+			.SelectionMode(ESelectionMode::Single)
+			.OnGenerateRow(this, &SLiveBlueprintReplayViewer::OnGenerateRow)
+			.HeaderRow(
+				SNew(SHeaderRow)
+
+				+ SHeaderRow::Column(c_NameColumnId)
+				.DefaultLabel(LOCTEXT("NameColumn", "Variable"))
+				.FillWidth(1.f)
+
+				+ SHeaderRow::Column(c_ValueColumnId)
+				.DefaultLabel(LOCTEXT("ValueColumn", "Value"))
+				.FillWidth(2.f))
+		]
+	];
+}
+
+FReply SLiveBlueprintReplayViewer::OnOpenClicked()
+{
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+
+	if (DesktopPlatform == nullptr)
+	{
+		return FReply::Handled();
+	}
+
+	TArray<FString> FilePaths;
+	const bool bFileChosen = DesktopPlatform->OpenFileDialog(
+		FSlateApplication::Get().FindBestParentWindowHandleForDialogs(AsShared()),
+		LOCTEXT("OpenRecordingTitle", "Open Live Blueprint Recording").ToString(),
+		FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("LiveBlueprintDebugger")),
+		FString(),
+		FString::Printf(
+			TEXT("Live Blueprint Recording (*.%s)|*.%s"),
+			LiveBlueprintRecordingFormat::FileExtension,
+			LiveBlueprintRecordingFormat::FileExtension),
+		EFileDialogFlags::None,
+		FilePaths);
+
+	if (bFileChosen && FilePaths.Num() > 0)
+	{
+		OpenRecording(FilePaths[0]);
+	}
+
+	return FReply::Handled();
+}
+
+void SLiveBlueprintReplayViewer::OpenRecording(const FString& FilePath)
+{
+	ErrorText = FText::GetEmpty();
+
+	if (!Reader.Open(FilePath, ErrorText))
+	{
+		SetInstance(INDEX_NONE);
+		return;
+	}
+
+	TimeInSeconds = 0.0;
+	SetInstance(Reader.GetInstances().Num() > 0 ? 0 : INDEX_NONE);
+}
+
+void SLiveBlueprintReplayViewer::SetInstance(int32 NewInstanceIndex)
+{
+	InstanceIndex = NewInstanceIndex;
+	RebuildItems();
+	UpdateValues();
+}
+
+void SLiveBlueprintReplayViewer::SetTime(double NewTimeInSeconds)
+{
+	TimeInSeconds = FMath::Clamp(NewTimeInSeconds, 0.0, Reader.GetDurationInSeconds());
+	UpdateValues();
+}
+
+void SLiveBlueprintReplayViewer::RebuildItems()
+{
+	Items.Reset();
+
+	if (!Reader.IsOpen() || InstanceIndex == INDEX_NONE)
+	{
+		ListView->RequestListRefresh();
+		return;
+	}
+
+	const FLiveBlueprintRecordedSchema& Schema = Reader.GetSchemas()[Reader.GetInstances()[InstanceIndex].SchemaIndex];
+	const FString* CurrentCategory = nullptr;
+
+	// Rows are recorded in the order of the details panel, with the variables of each category next
+	// to each other, so a header is added whenever the category changes.
+	for (int32 RowIndex = 0; RowIndex < Schema.Rows.Num(); RowIndex++)
+	{
+		const FLiveBlueprintRecordedRow& Row = Schema.Rows[RowIndex];
+
+		if (Row.ParentIndex == INDEX_NONE && (CurrentCategory == nullptr || *CurrentCategory != Row.Category))
+		{
+			CurrentCategory = &Row.Category;
+
+			FItemPtr CategoryItem = MakeShared<FLiveBlueprintReplayItem>();
+			CategoryItem->Name = FText::FromString(Row.Category);
+			Items.Add(CategoryItem);
+		}
+
+		FItemPtr Item = MakeShared<FLiveBlueprintReplayItem>();
+		Item->RowIndex = RowIndex;
+		Item->Depth = Row.Depth + 1;
+		Item->Name = FText::FromString(Row.Name);
+		Item->TypeText = FText::FromString(Row.TypeText);
+		Items.Add(Item);
+	}
+
+	ListView->RequestListRefresh();
+}
+
+void SLiveBlueprintReplayViewer::UpdateValues()
+{
+	if (!Reader.IsOpen() || InstanceIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	Reader.Seek(InstanceIndex, TimeInSeconds, ValueRecordOffsets);
+
+	for (const FItemPtr& Item : Items)
+	{
+		if (Item->RowIndex != INDEX_NONE)
+		{
+			Item->ValueText = FText::FromString(
+				Reader.GetValueText(InstanceIndex, Item->RowIndex, ValueRecordOffsets[Item->RowIndex]));
+		}
+	}
+}
+
+TSharedRef<SWidget> SLiveBlueprintReplayViewer::GetInstanceMenuContent()
+{
+	FMenuBuilder MenuBuilder(true, nullptr);
+	const TArray<FLiveBlueprintRecordedInstance>& Instances = Reader.GetInstances();
+
+	for (int32 Index = 0; Index < Instances.Num(); Index++)
+	{
+		MenuBuilder.AddMenuEntry(
+			FText::FromString(Instances[Index].ActorLabel),
+			FText::FromString(Instances[Index].ActorPath),
+			FSlateIcon(),
+			FUIAction(FExecuteAction::CreateSP(this, &SLiveBlueprintReplayViewer::SetInstance, Index)));
+	}
+
+	return MenuBuilder.MakeWidget();
+}
+
+FText SLiveBlueprintReplayViewer::GetInstanceText() const
+{
+	return (InstanceIndex != INDEX_NONE) ?
+		FText::FromString(Reader.GetInstances()[InstanceIndex].ActorLabel) :
+		LOCTEXT("NoRecordedActor", "Choose a recorded Actor");
+}
+
+FText SLiveBlueprintReplayViewer::GetStatusText() const
+{
+	if (!ErrorText.IsEmpty())
+	{
+		return ErrorText;
+	}
+
+	if (!Reader.IsOpen())
+	{
+		return LOCTEXT("NoRecording", "No recording opened.");
+	}
+
+	return FText::Format(
+		LOCTEXT("RecordingStatus", "{0} ({1} Actors)"),
+		FText::FromString(FPaths::GetCleanFilename(Reader.GetFilePath())),
+		Reader.GetInstances().Num());
+}
+
+FText SLiveBlueprintReplayViewer::GetTimeText() const
+{
+	FNumberFormattingOptions SecondsFormat;
+	SecondsFormat.MinimumFractionalDigits = 2;
+	SecondsFormat.MaximumFractionalDigits = 2;
+
+	return FText::Format(
+		LOCTEXT("ReplayTime", "{0}s / {1}s"),
+		FText::AsNumber(TimeInSeconds, &SecondsFormat),
+		FText::AsNumber(Reader.GetDurationInSeconds(), &SecondsFormat));
+}
+
+float SLiveBlueprintReplayViewer::GetTimelinePosition() const
+{
+	const double DurationInSeconds = Reader.GetDurationInSeconds();
+	return (DurationInSeconds > 0.0) ? static_cast<float>(TimeInSeconds / DurationInSeconds) : 0.0f;
+}
+
+void SLiveBlueprintReplayViewer::OnTimelinePositionChanged(float Position)
+{
+	SetTime(Position * Reader.GetDurationInSeconds());
+}
+
+TSharedRef<ITableRow> SLiveBlueprintReplayViewer::OnGenerateRow(FItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SLiveBlueprintReplayRow, OwnerTable, Item);
+}
+
+#undef LOCTEXT_NAMESPACE
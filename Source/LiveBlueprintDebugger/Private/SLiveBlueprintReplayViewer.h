@@ -0,0 +1,67 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+#include "LiveBlueprintRecordingReader.h"
+
+class ITableRow;
+class STableViewBase;
+
+// One row of the replay viewer: either a category header or a recorded variable.
+struct FLiveBlueprintReplayItem
+{
+	// INDEX_NONE for category headers.
+	int32 RowIndex = INDEX_NONE;
+	int32 Depth = 0;
+	FText Name;
+	FText TypeText;
+	FText ValueText;
+};
+
+// SLiveBlueprintReplayViewer is the content of the "Live Blueprint Replay" tab. It opens a
+// recording made with LiveBlueprintDebugger.StartRecording and shows the variables of one recorded
+// actor at the time chosen on the timeline, laid out by category and nesting like the details
+// panel. Moving the timeline seeks the recording, so scrubbing stays fast for long recordings.
+class SLiveBlueprintReplayViewer : public SCompoundWidget
+{
+public:
+	static const FName TabName;
+
+	SLATE_BEGIN_ARGS(SLiveBlueprintReplayViewer) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+private:
+	using FItemPtr = TSharedPtr<FLiveBlueprintReplayItem>;
+
+	FReply OnOpenClicked();
+	void OpenRecording(const FString& FilePath);
+	void SetInstance(int32 InstanceIndex);
+	void SetTime(double TimeInSeconds);
+	void RebuildItems();
+	void UpdateValues();
+
+	TSharedRef<SWidget> GetInstanceMenuContent();
+	FText GetInstanceText() const;
+	FText GetStatusText() const;
+	FText GetTimeText() const;
+	float GetTimelinePosition() const;
+	void OnTimelinePositionChanged(float Position);
+	TSharedRef<ITableRow> OnGenerateRow(FItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
+
+	FLiveBlueprintRecordingReader Reader;
+	FText ErrorText;
+	int32 InstanceIndex = INDEX_NONE;
+	double TimeInSeconds = 0.0;
+
+	// The Value record of every row of the current instance at the current time.
+	TArray<int64> ValueRecordOffsets;
+
+	TArray<FItemPtr> Items;
+	TSharedPtr<SListView<FItemPtr>> ListView;
+};
@@ -0,0 +1,191 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "SLiveBlueprintSparkline.h"
+
+#include "LiveBlueprintValueHistory.h"
+#include "Rendering/DrawElements.h"
+
+#define LOCTEXT_NAMESPACE "FLiveBlueprintDebuggerModule"
+
+static const FLinearColor c_SparklineColor = FLinearColor(0.2f, 0.6f, 1.0f, 1.0f);
+static const FLinearColor c_HoverMarkerColor = FLinearColor(1.0f, 1.0f, 1.0f, 0.5f);
+
+void SLiveBlueprintSparkline::Construct(const FArguments& InArgs)
+{
+	History = InArgs._History;
+	SlotIndex = InArgs._SlotIndex;
+	WindowInSeconds = FMath::Max(InArgs._WindowInSeconds, 0.1);
+
+	SetToolTipText(TAttribute<FText>::Create(TAttribute<FText>::FGetter::CreateSP(this, &SLiveBlueprintSparkline::GetHoverText)));
+}
+
+int32 SLiveBlueprintSparkline::OnPaint(
+	const FPaintArgs& Args,
+	const FGeometry& AllottedGeometry,
+	const FSlateRect& MyCullingRect,
+	FSlateWindowElementList& OutDrawElements,
+	int32 LayerId,
+	const FWidgetStyle& InWidgetStyle,
+	bool bParentEnabled) const
+{
+	TSharedPtr<const FLiveBlueprintValueHistory> PinnedHistory = History.Pin();
+
+	if (!PinnedHistory.IsValid() || SlotIndex == INDEX_NONE || PinnedHistory->GetNumSamples(SlotIndex) == 0)
+	{
+		return LayerId;
+	}
+
+	const FLiveBlueprintValueHistory& ValueHistory = *PinnedHistory;
+	const int32 NumSamples = ValueHistory.GetNumSamples(SlotIndex);
+	const double EndTime = ValueHistory.GetCurrentTime();
+	const double StartTime = EndTime - WindowInSeconds;
+	const FVector2D Size = AllottedGeometry.GetLocalSize();
+
+	// Find the first sample inside the window. The sample before it holds the value at the start
+	// of the window.
+	int32 FirstSampleIndex = 0;
+
+	while (FirstSampleIndex < NumSamples && ValueHistory.GetSampleTime(SlotIndex, FirstSampleIndex) < StartTime)
+	{
+		FirstSampleIndex++;
+	}
+
+	const int32 FirstVisibleSampleIndex = FMath::Max(FirstSampleIndex - 1, 0);
+	double MinValue = TNumericLimits<double>::Max();
+	double MaxValue = TNumericLimits<double>::Lowest();
+
+	for (int32 SampleIndex = FirstVisibleSampleIndex; SampleIndex < NumSamples; SampleIndex++)
+	{
+		const double Value = ValueHistory.GetSampleValue(SlotIndex, SampleIndex);
+		MinValue = FMath::Min(MinValue, Value);
+		MaxValue = FMath::Max(MaxValue, Value);
+	}
+
+	auto GetX = [&](double TimeInSeconds)
+	{
+		return static_cast<float>(FMath::Clamp((TimeInSeconds - StartTime) / WindowInSeconds, 0.0, 1.0) * Size.X);
+	};
+
+	auto GetY = [&](double Value)
+	{
+		const double Fraction = (MaxValue > MinValue) ? (Value - MinValue) / (MaxValue - MinValue) : 0.5;
+		return static_cast<float>((1.0 - Fraction) * (Size.Y - 2.0) + 1.0);
+	};
+
+	// Values hold until the next sample, so the line is drawn as steps.
+	LinePoints.Reset();
+
+	double PreviousValue = ValueHistory.GetSampleValue(SlotIndex, FirstVisibleSampleIndex);
+	LinePoints.Add(FVector2D(GetX(ValueHistory.GetSampleTime(SlotIndex, FirstVisibleSampleIndex)), GetY(PreviousValue)));
+
+	for (int32 SampleIndex = FirstVisibleSampleIndex + 1; SampleIndex < NumSamples; SampleIndex++)
+	{
+		const float X = GetX(ValueHistory.GetSampleTime(SlotIndex, SampleIndex));
+		const double Value = ValueHistory.GetSampleValue(SlotIndex, SampleIndex);
+
+		LinePoints.Add(FVector2D(X, GetY(PreviousValue)));
+		LinePoints.Add(FVector2D(X, GetY(Value)));
+		PreviousValue = Value;
+	}
+
+	LinePoints.Add(FVector2D(Size.X, GetY(PreviousValue)));
+
+	FSlateDrawElement::MakeLines(
+		OutDrawElements,
+		LayerId,
+		AllottedGeometry.ToPaintGeometry(),
+		LinePoints,
+		ESlateDrawEffect::None,
+		c_SparklineColor * InWidgetStyle.GetColorAndOpacityTint(),
+		true,
+		1.0f);
+
+	if (HoverFraction >= 0.0f)
+	{
+		const float HoverX = HoverFraction * Size.X;
+
+		FSlateDrawElement::MakeLines(
+			OutDrawElements,
+			LayerId + 1,
+			AllottedGeometry.ToPaintGeometry(),
+			{ FVector2D(HoverX, 0.0f), FVector2D(HoverX, Size.Y) },
+			ESlateDrawEffect::None,
+			c_HoverMarkerColor,
+			false,
+			1.0f);
+	}
+
+	return LayerId + 1;
+}
+
+FReply SLiveBlueprintSparkline::OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	const FVector2D LocalPosition = MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition());
+	const FVector2D Size = MyGeometry.GetLocalSize();
+
+	HoverFraction = (Size.X > 0.0f) ? FMath::Clamp(static_cast<float>(LocalPosition.X / Size.X), 0.0f, 1.0f) : -1.0f;
+
+	return FReply::Unhandled();
+}
+
+void SLiveBlueprintSparkline::OnMouseLeave(const FPointerEvent& MouseEvent)
+{
+	SLeafWidget::OnMouseLeave(MouseEvent);
+
+	HoverFraction = -1.0f;
+}
+
+FVector2D SLiveBlueprintSparkline::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	return FVector2D(64.0f, 16.0f);
+}
+
+bool SLiveBlueprintSparkline::GetValueAtTime(
+	const FLiveBlueprintValueHistory& ValueHistory,
+	double TimeInSeconds,
+	double& OutValue) const
+{
+	bool bFoundValue = false;
+
+	for (int32 SampleIndex = 0; SampleIndex < ValueHistory.GetNumSamples(SlotIndex); SampleIndex++)
+	{
+		if (ValueHistory.GetSampleTime(SlotIndex, SampleIndex) > TimeInSeconds)
+		{
+			break;
+		}
+
+		OutValue = ValueHistory.GetSampleValue(SlotIndex, SampleIndex);
+		bFoundValue = true;
+	}
+
+	return bFoundValue;
+}
+
+FText SLiveBlueprintSparkline::GetHoverText() const
+{
+	TSharedPtr<const FLiveBlueprintValueHistory> PinnedHistory = History.Pin();
+
+	if (!PinnedHistory.IsValid() || SlotIndex == INDEX_NONE || HoverFraction < 0.0f)
+	{
+		return FText::GetEmpty();
+	}
+
+	const double SecondsAgo = (1.0 - HoverFraction) * WindowInSeconds;
+	double Value = 0.0;
+
+	if (!GetValueAtTime(*PinnedHistory, PinnedHistory->GetCurrentTime() - SecondsAgo, Value))
+	{
+		return LOCTEXT("NoHistory", "No value recorded yet.");
+	}
+
+	FNumberFormattingOptions SecondsFormat;
+	SecondsFormat.MinimumFractionalDigits = 1;
+	SecondsFormat.MaximumFractionalDigits = 1;
+
+	return FText::Format(
+		LOCTEXT("SparklineHover", "{0} ({1}s ago)"),
+		FText::AsNumber(Value),
+		FText::AsNumber(SecondsAgo, &SecondsFormat));
+}
+
+#undef LOCTEXT_NAMESPACE
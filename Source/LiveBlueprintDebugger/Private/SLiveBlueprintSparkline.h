@@ -0,0 +1,56 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+
+class FLiveBlueprintValueHistory;
+
+// SLiveBlueprintSparkline draws the recent history of one numeric, enum, or bool variable as a
+// small line graph next to its value. The graph spans the last WindowInSeconds seconds and is
+// scaled to the minimum and maximum value in that window. Hovering over the graph shows the value
+// at that point in time.
+class SLiveBlueprintSparkline : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SLiveBlueprintSparkline) :
+		_SlotIndex(INDEX_NONE),
+		_WindowInSeconds(10.0)
+	{}
+		SLATE_ARGUMENT(TSharedPtr<const FLiveBlueprintValueHistory>, History)
+		SLATE_ARGUMENT(int32, SlotIndex)
+		SLATE_ARGUMENT(double, WindowInSeconds)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	virtual int32 OnPaint(
+		const FPaintArgs& Args,
+		const FGeometry& AllottedGeometry,
+		const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements,
+		int32 LayerId,
+		const FWidgetStyle& InWidgetStyle,
+		bool bParentEnabled) const override;
+
+	virtual FReply OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual void OnMouseLeave(const FPointerEvent& MouseEvent) override;
+
+protected:
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+	bool GetValueAtTime(const FLiveBlueprintValueHistory& History, double TimeInSeconds, double& OutValue) const;
+	FText GetHoverText() const;
+
+	TWeakPtr<const FLiveBlueprintValueHistory> History;
+	int32 SlotIndex = INDEX_NONE;
+	double WindowInSeconds = 10.0;
+
+	// The hovered position as a fraction of the widget width, or a negative value when not hovered.
+	float HoverFraction = -1.0f;
+
+	// Reused between paints so that drawing doesn't allocate once the array has grown.
+	mutable TArray<FVector2D> LinePoints;
+};
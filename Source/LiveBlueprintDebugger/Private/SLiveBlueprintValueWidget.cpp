@@ -0,0 +1,401 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#include "SLiveBlueprintValueWidget.h"
+
+#include "Brushes/SlateColorBrush.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/SNullWidget.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "FLiveBlueprintDebuggerModule"
+
+static const FSlateColorBrush c_HighlightedBackgroundBrush = FSlateColorBrush(FLinearColor::White);
+
+// How far the members of an expanded reference are indented per level.
+static constexpr float c_ExpansionIndentPerDepth = 12.f;
+
+// How long after its last paint a widget is still considered visible. This is a few frames long so
+// that a single skipped frame doesn't cause the value to stop updating.
+static constexpr double c_VisibilityTimeoutInSeconds = 0.25;
+
+void SLiveBlueprintValueWidget::Construct(const FArguments& InArgs)
+{
+	bShowElementNames = InArgs._ShowElementNames || InArgs._IsReference;
+	ElementsPerPage = FMath::Max(1, InArgs._ElementsPerPage);
+	OnExpanderClicked = InArgs._OnExpanderClicked;
+	OnPageChanged = InArgs._OnPageChanged;
+
+	TSharedRef<SWidget> ValueContent = SNullWidget::NullWidget;
+
+	if (InArgs._IsContainer)
+	{
+		ValueContent =
+			SAssignNew(ElementsBox, SVerticalBox)
+
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(PageControls, SHorizontalBox)
+				.Visibility(EVisibility::Collapsed)
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					SAssignNew(PageTextBlock, STextBlock)
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(4.f, 0.f, 0.f, 0.f)
+				[
+					SNew(SButton)
+					.Text(FText::FromString("<"))
+					.ToolTipText(LOCTEXT("PreviousPage", "Show the previous page of elements."))
+					.OnClicked(this, &SLiveBlueprintValueWidget::OnPreviousPageClicked)
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SButton)
+					.Text(FText::FromString(">"))
+					.ToolTipText(LOCTEXT("NextPage", "Show the next page of elements."))
+					.OnClicked(this, &SLiveBlueprintValueWidget::OnNextPageClicked)
+				]
+			]
+
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(EmptyTextBlock, STextBlock)
+				.Text(FText::FromString("[empty]"))
+			];
+	}
+	else if (InArgs._IsReference)
+	{
+		// The members of the referenced object are listed below the value once it is expanded.
+		ValueContent =
+			SNew(SVerticalBox)
+
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SHorizontalBox)
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					MakeExpanderButton(INDEX_NONE, ExpanderTextBlock)
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				.Padding(4.f, 0.f, 0.f, 0.f)
+				[
+					SAssignNew(ValueTextBlock, STextBlock)
+				]
+			]
+
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(ElementsBox, SVerticalBox)
+				.Visibility(EVisibility::Collapsed)
+
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SAssignNew(EmptyTextBlock, STextBlock)
+					.Text(LOCTEXT("NoReferenceMembers", "[no Blueprint variables]"))
+				]
+			];
+	}
+	else
+	{
+		ValueContent = SAssignNew(ValueTextBlock, STextBlock);
+	}
+
+	ChildSlot
+	[
+		SAssignNew(HighlightBorder, SBorder)
+		.HAlign(EHorizontalAlignment::HAlign_Fill)
+		.VAlign(EVerticalAlignment::VAlign_Fill)
+		.BorderBackgroundColor(FColor::Transparent)
+		.BorderImage(&c_HighlightedBackgroundBrush)
+		.Content()
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.HAlign(HAlign_Left)
+			.Padding(.5f, 1.f)
+			[
+				ValueContent
+			]
+		]
+	];
+}
+
+void SLiveBlueprintValueWidget::SetValueText(const FText& ValueText)
+{
+	if (ValueTextBlock.IsValid())
+	{
+		ValueTextBlock->SetText(ValueText);
+		ValueTextBlock->SetToolTipText(ValueText);
+	}
+}
+
+void SLiveBlueprintValueWidget::SetNumElements(int32 InNumElements)
+{
+	if (!ElementsBox.IsValid() || InNumElements == NumElements)
+	{
+		return;
+	}
+
+	while (ElementWidgets.Num() < InNumElements)
+	{
+		AddElementWidgets();
+	}
+
+	for (int32 ElementIndex = 0; ElementIndex < ElementWidgets.Num(); ElementIndex++)
+	{
+		ElementWidgets[ElementIndex].Container->SetVisibility(
+			ElementIndex < InNumElements ? EVisibility::Visible : EVisibility::Collapsed);
+	}
+
+	EmptyTextBlock->SetVisibility(InNumElements == 0 ? EVisibility::Visible : EVisibility::Collapsed);
+	NumElements = InNumElements;
+}
+
+void SLiveBlueprintValueWidget::SetTotalNumElements(int32 InTotalNumElements)
+{
+	if (!PageControls.IsValid() || InTotalNumElements == TotalNumElements)
+	{
+		return;
+	}
+
+	TotalNumElements = InTotalNumElements;
+
+	// Stay on the last page if elements were removed from it.
+	const int32 LastPageStart = FMath::Max(0, ((TotalNumElements - 1) / ElementsPerPage) * ElementsPerPage);
+	FirstVisibleElement = FMath::Min(FirstVisibleElement, LastPageStart);
+
+	PageControls->SetVisibility(TotalNumElements > ElementsPerPage ? EVisibility::Visible : EVisibility::Collapsed);
+	UpdatePageText();
+}
+
+int32 SLiveBlueprintValueWidget::GetFirstVisibleElement() const
+{
+	return FirstVisibleElement;
+}
+
+int32 SLiveBlueprintValueWidget::GetElementsPerPage() const
+{
+	return ElementsPerPage;
+}
+
+void SLiveBlueprintValueWidget::SetElementText(int32 ElementIndex, const FText& NameText, const FText& ValueText)
+{
+	if (!ElementWidgets.IsValidIndex(ElementIndex))
+	{
+		return;
+	}
+
+	FElementWidgets& Element = ElementWidgets[ElementIndex];
+
+	if (bShowElementNames)
+	{
+		Element.NameTextBlock->SetText(NameText);
+		Element.NameTextBlock->SetToolTipText(NameText);
+	}
+
+	Element.ValueTextBlock->SetText(ValueText);
+	Element.ValueTextBlock->SetToolTipText(ValueText);
+}
+
+void SLiveBlueprintValueWidget::SetHighlightColor(const FLinearColor& HighlightColor)
+{
+	HighlightBorder->SetBorderBackgroundColor(HighlightColor);
+}
+
+void SLiveBlueprintValueWidget::SetElementHighlightColor(int32 ElementIndex, const FLinearColor& HighlightColor)
+{
+	if (ElementWidgets.IsValidIndex(ElementIndex))
+	{
+		ElementWidgets[ElementIndex].HighlightBorder->SetBorderBackgroundColor(HighlightColor);
+	}
+}
+
+void SLiveBlueprintValueWidget::SetElementExpander(int32 ElementIndex, int32 Depth, EExpander Expander)
+{
+	if (!ElementWidgets.IsValidIndex(ElementIndex))
+	{
+		return;
+	}
+
+	// Elements without an expander still keep its space, so that members at the same depth line up.
+	FElementWidgets& Element = ElementWidgets[ElementIndex];
+	Element.IndentBox->SetWidthOverride(FOptionalSize(Depth * c_ExpansionIndentPerDepth));
+	Element.ExpanderButton->SetVisibility(Expander == EExpander::None ? EVisibility::Hidden : EVisibility::Visible);
+	Element.ExpanderTextBlock->SetText(FText::FromString(Expander == EExpander::Expanded ? "-" : "+"));
+}
+
+void SLiveBlueprintValueWidget::SetExpanded(bool bInIsExpanded)
+{
+	if (!ExpanderTextBlock.IsValid())
+	{
+		return;
+	}
+
+	ExpanderTextBlock->SetText(FText::FromString(bInIsExpanded ? "-" : "+"));
+	ElementsBox->SetVisibility(bInIsExpanded ? EVisibility::Visible : EVisibility::Collapsed);
+}
+
+void SLiveBlueprintValueWidget::SetOnExpanderClicked(const FOnLiveBlueprintExpanderClicked& InOnExpanderClicked)
+{
+	OnExpanderClicked = InOnExpanderClicked;
+}
+
+void SLiveBlueprintValueWidget::SetOnPageChanged(const FOnLiveBlueprintPageChanged& InOnPageChanged)
+{
+	OnPageChanged = InOnPageChanged;
+}
+
+bool SLiveBlueprintValueWidget::WasPaintedRecently(double CurrentTimeInSeconds) const
+{
+	return (CurrentTimeInSeconds - LastPaintTime) <= c_VisibilityTimeoutInSeconds;
+}
+
+int32 SLiveBlueprintValueWidget::OnPaint(
+	const FPaintArgs& Args, 
+	const FGeometry& AllottedGeometry, 
+	const FSlateRect& MyCullingRect, 
+	FSlateWindowElementList& OutDrawElements, 
+	int32 LayerId, 
+	const FWidgetStyle& InWidgetStyle, 
+	bool bParentEnabled) const
+{
+	LastPaintTime = FSlateApplication::Get().GetCurrentTime();
+
+	return SCompoundWidget::OnPaint(
+		Args, 
+		AllottedGeometry, 
+		MyCullingRect, 
+		OutDrawElements, 
+		LayerId, 
+		InWidgetStyle, 
+		bParentEnabled);
+}
+
+void SLiveBlueprintValueWidget::UpdatePageText()
+{
+	PageTextBlock->SetText(FText::Format(
+		LOCTEXT("ElementPage", "Elements {0}-{1} of {2}"),
+		FText::AsNumber(FirstVisibleElement + 1),
+		FText::AsNumber(FMath::Min(FirstVisibleElement + ElementsPerPage, TotalNumElements)),
+		FText::AsNumber(TotalNumElements)));
+}
+
+FReply SLiveBlueprintValueWidget::OnPreviousPageClicked()
+{
+	if (FirstVisibleElement > 0)
+	{
+		FirstVisibleElement = FMath::Max(0, FirstVisibleElement - ElementsPerPage);
+		UpdatePageText();
+		OnPageChanged.ExecuteIfBound();
+	}
+
+	return FReply::Handled();
+}
+
+FReply SLiveBlueprintValueWidget::OnNextPageClicked()
+{
+	if (FirstVisibleElement + ElementsPerPage < TotalNumElements)
+	{
+		FirstVisibleElement += ElementsPerPage;
+		UpdatePageText();
+		OnPageChanged.ExecuteIfBound();
+	}
+
+	return FReply::Handled();
+}
+
+FReply SLiveBlueprintValueWidget::OnExpanderButtonClicked(int32 ElementIndex)
+{
+	OnExpanderClicked.ExecuteIfBound(ElementIndex);
+	return FReply::Handled();
+}
+
+TSharedRef<SWidget> SLiveBlueprintValueWidget::MakeExpanderButton(int32 ElementIndex, TSharedPtr<STextBlock>& OutTextBlock)
+{
+	return SNew(SButton)
+		.ContentPadding(FMargin(2.f, 0.f))
+		.ToolTipText(LOCTEXT("ExpandReference", "Show or hide the Blueprint variables of the referenced object."))
+		.OnClicked(this, &SLiveBlueprintValueWidget::OnExpanderButtonClicked, ElementIndex)
+		[
+			SAssignNew(OutTextBlock, STextBlock)
+			.Text(FText::FromString("+"))
+		];
+}
+
+void SLiveBlueprintValueWidget::AddElementWidgets()
+{
+	const int32 ElementIndex = ElementWidgets.Num();
+	FElementWidgets& Element = ElementWidgets.AddDefaulted_GetRef();
+
+	ElementsBox->AddSlot()
+		.AutoHeight()
+		[
+			SAssignNew(Element.Container, SHorizontalBox)
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SAssignNew(Element.IndentBox, SBox)
+				.WidthOverride(0.f)
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(0.f, 0.f, 4.f, 0.f)
+			[
+				SAssignNew(Element.ExpanderButton, SBox)
+				.Visibility(EVisibility::Collapsed)
+				[
+					MakeExpanderButton(ElementIndex, Element.ExpanderTextBlock)
+				]
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SAssignNew(Element.NameTextBlock, STextBlock)
+				.Visibility(bShowElementNames ? EVisibility::Visible : EVisibility::Collapsed)
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.HAlign(HAlign_Left)
+			.Padding(.5f, 1.f)
+			[
+				SAssignNew(Element.HighlightBorder, SBorder)
+				.BorderBackgroundColor(FColor::Transparent)
+				.BorderImage(&c_HighlightedBackgroundBrush)
+				.Content()
+				[
+					SAssignNew(Element.ValueTextBlock, STextBlock)
+				]
+			]
+		];
+}
+
+#undef LOCTEXT_NAMESPACE
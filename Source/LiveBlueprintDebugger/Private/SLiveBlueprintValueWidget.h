@@ -0,0 +1,122 @@
+// Copyright (c) 2022-2023 Justin Nordin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+
+class SBorder;
+class SBox;
+class STextBlock;
+class SVerticalBox;
+
+// Called with the index of the element whose expander was clicked, or INDEX_NONE for the value's own
+// expander.
+DECLARE_DELEGATE_OneParam(FOnLiveBlueprintExpanderClicked, int32);
+
+// Called when the user switches a container to a different page of elements.
+DECLARE_DELEGATE(FOnLiveBlueprintPageChanged);
+
+// SLiveBlueprintValueWidget displays the value of one Blueprint variable in the details panel.
+//
+// Its widgets are created once and kept alive for the lifetime of the row. When the value changes,
+// only the text of the existing text blocks is updated. Set, array, and map variables show one
+// line per element using a pool of element widgets that only ever grows; elements beyond the
+// current number of container elements are collapsed rather than destroyed.
+//
+// Large containers are paged: only one page of elements is ever shown, and the owner is expected
+// to query GetFirstVisibleElement and only format the elements on the current page. OnPageChanged
+// lets the owner fill in the new page as soon as the user switches to it.
+//
+// Object and interface variables show an expander next to their value. The owner decides what
+// expanding means: it fills in one line per member of the referenced object with the same element
+// widgets, and any element can get an expander of its own, indented by its depth.
+//
+// The widget also remembers when it was last painted. The details panel only generates and paints
+// rows that are on screen, inside expanded groups and categories, and not hidden by the search
+// filter, so this is used to skip updating values the user can't see.
+class SLiveBlueprintValueWidget : public SCompoundWidget
+{
+public:
+	enum class EExpander : uint8
+	{
+		None,
+		Collapsed,
+		Expanded
+	};
+
+	SLATE_BEGIN_ARGS(SLiveBlueprintValueWidget) :
+		_IsContainer(false),
+		_IsReference(false),
+		_ShowElementNames(false),
+		_ElementsPerPage(20)
+	{}
+		SLATE_ARGUMENT(bool, IsContainer)
+		SLATE_ARGUMENT(bool, IsReference)
+		SLATE_ARGUMENT(bool, ShowElementNames)
+		SLATE_ARGUMENT(int32, ElementsPerPage)
+		SLATE_EVENT(FOnLiveBlueprintExpanderClicked, OnExpanderClicked)
+		SLATE_EVENT(FOnLiveBlueprintPageChanged, OnPageChanged)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	void SetValueText(const FText& ValueText);
+	void SetNumElements(int32 NumElements);
+	void SetTotalNumElements(int32 TotalNumElements);
+	int32 GetFirstVisibleElement() const;
+	int32 GetElementsPerPage() const;
+	void SetElementText(int32 ElementIndex, const FText& NameText, const FText& ValueText);
+	void SetHighlightColor(const FLinearColor& HighlightColor);
+	void SetElementHighlightColor(int32 ElementIndex, const FLinearColor& HighlightColor);
+	void SetElementExpander(int32 ElementIndex, int32 Depth, EExpander Expander);
+	void SetExpanded(bool bInIsExpanded);
+	void SetOnExpanderClicked(const FOnLiveBlueprintExpanderClicked& InOnExpanderClicked);
+	void SetOnPageChanged(const FOnLiveBlueprintPageChanged& InOnPageChanged);
+	bool WasPaintedRecently(double CurrentTimeInSeconds) const;
+
+	virtual int32 OnPaint(
+		const FPaintArgs& Args, 
+		const FGeometry& AllottedGeometry, 
+		const FSlateRect& MyCullingRect, 
+		FSlateWindowElementList& OutDrawElements, 
+		int32 LayerId, 
+		const FWidgetStyle& InWidgetStyle, 
+		bool bParentEnabled) const override;
+
+private:
+	struct FElementWidgets
+	{
+		TSharedPtr<SWidget> Container;
+		TSharedPtr<SBox> IndentBox;
+		TSharedPtr<SWidget> ExpanderButton;
+		TSharedPtr<STextBlock> ExpanderTextBlock;
+		TSharedPtr<SBorder> HighlightBorder;
+		TSharedPtr<STextBlock> NameTextBlock;
+		TSharedPtr<STextBlock> ValueTextBlock;
+	};
+
+	void AddElementWidgets();
+	void UpdatePageText();
+	FReply OnPreviousPageClicked();
+	FReply OnNextPageClicked();
+	FReply OnExpanderButtonClicked(int32 ElementIndex);
+	TSharedRef<SWidget> MakeExpanderButton(int32 ElementIndex, TSharedPtr<STextBlock>& OutTextBlock);
+
+	bool bShowElementNames = false;
+	int32 NumElements = 0;
+	int32 TotalNumElements = 0;
+	int32 ElementsPerPage = 20;
+	int32 FirstVisibleElement = 0;
+	TSharedPtr<SBorder> HighlightBorder;
+	TSharedPtr<STextBlock> ValueTextBlock;
+	TSharedPtr<SVerticalBox> ElementsBox;
+	TSharedPtr<STextBlock> EmptyTextBlock;
+	TSharedPtr<SWidget> PageControls;
+	TSharedPtr<STextBlock> PageTextBlock;
+	TSharedPtr<STextBlock> ExpanderTextBlock;
+	FOnLiveBlueprintExpanderClicked OnExpanderClicked;
+	FOnLiveBlueprintPageChanged OnPageChanged;
+	TArray<FElementWidgets> ElementWidgets;
+	mutable double LastPaintTime = TNumericLimits<double>::Lowest();
+};
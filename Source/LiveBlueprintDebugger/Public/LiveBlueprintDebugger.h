@@ -28,6 +28,14 @@ private:
 	FDelegateHandle PostPIEStartedDelegateHandle;
 	FDelegateHandle OnPreSwitchBeginPIEAndSIEDelegateHandle;
 	FDelegateHandle OnSwitchBeginPIEAndSIEDelegateHandle;
-	TUniquePtr<class FLiveBlueprintDebuggerDetailCustomization> CurrentDetailCustomization;
+
+	// One customization per details panel that shows a Blueprint actor. Locked panels keep their
+	// customization while other panels are customized for newly selected actors.
+	TArray<TUniquePtr<class FLiveBlueprintDebuggerDetailCustomization>> DetailCustomizations;
+
+	// The rows of recently customized actors, kept so that rebuilding a details panel for the same
+	// actors doesn't have to start from scratch.
+	TUniquePtr<class FLiveBlueprintSelectionStateCache> SelectionStateCache;
+	FDelegateHandle SettingsChangedDelegateHandle;
 	TWeakObjectPtr<AActor> ActorToReselect;
 };
@@ -56,12 +56,36 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "Live Blueprint Debugger")
 	EPropertyRefreshRate PropertyRefreshRate = EPropertyRefreshRate::Ten;
 
+	UPROPERTY(Config, EditAnywhere, Category = "Live Blueprint Debugger", DisplayName = "Update Budget (Microseconds)", meta=(ClampMin="0", UIMin="0"))
+	int32 UpdateBudgetMicroseconds = 1000;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Live Blueprint Debugger", DisplayName = "Refresh variables that rarely change less often.")
+	bool bAdaptiveRefreshRate = true;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Live Blueprint Debugger", DisplayName = "Detect changes by comparing the memory of all variables at once.")
+	bool bSnapshotDiffing = false;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Live Blueprint Debugger", DisplayName = "Variable Refresh Rate Overrides (Hz)", meta=(ClampMin="0", UIMin="0"))
+	TMap<FName, float> VariableRefreshRateOverrides;
+
 	UPROPERTY(Config, EditAnywhere, Category = "Live Blueprint Debugger")
 	bool bHighlightValuesThatHaveChanged = true;
 
 	UPROPERTY(Config, EditAnywhere, Category = "Live Blueprint Debugger", meta=(EditCondition="bHighlightValuesThatHaveChanged"))
 	FLinearColor PropertyChangedHighlightColor = FLinearColor(0.0f, 1.0f, 0.0f, 0.6f);
 
+	UPROPERTY(Config, EditAnywhere, Category = "Live Blueprint Debugger", meta=(ClampMin="1", UIMin="1", ToolTip="The maximum number of set, array, or map elements that are shown at once. Only the elements on the current page are formatted. Arrays are also only checked for changes on the current page, but sets and maps are hashed in full every time they are checked, so their cost still grows with the number of elements."))
+	int32 ContainerElementsPerPage = 20;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Live Blueprint Debugger", DisplayName = "Show a history graph next to number, enum, and bool variables.")
+	bool bShowValueHistory = true;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Live Blueprint Debugger", meta=(EditCondition="bShowValueHistory", ClampMin="2", UIMin="2", ClampMax="4096"))
+	int32 ValueHistorySamples = 256;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Live Blueprint Debugger", DisplayName = "Show the cost of the debugger above the Blueprint variables.")
+	bool bShowDebuggerOverhead = false;
+
 	UPROPERTY(Config, EditAnywhere, Category = "Live Blueprint Debugger", DisplayName = "Keep actor selected when playing in editor, ejecting, and possessing.")
 	bool bKeepActorSelected = false;
 };